@@ -122,6 +122,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Indexer* _M_index;
 
     template<typename _Tp> friend class valarray;
+    template<typename _Tp> friend class gslice_array;
   };
 
   inline size_t
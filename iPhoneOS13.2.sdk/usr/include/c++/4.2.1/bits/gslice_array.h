@@ -121,20 +121,100 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
     private:
       _Array<_Tp>    _M_array;
-      const valarray<size_t>& _M_index;
+      const gslice::_Indexer& _M_index;
 
       friend class valarray<_Tp>;
 
-      gslice_array(_Array<_Tp>, const valarray<size_t>&);
+      gslice_array(_Array<_Tp>, const gslice::_Indexer&);
+
+      // Calls __row for each row of the gslice (see
+      // __valarray_gslice_rows).
+      template<class _Row>
+        void _M_rows(_Row&) const;
 
       // not implemented
       gslice_array();
     };
 
+  //
+  // The rows of a gslice_array are strided arrays, which the kernels
+  // below handle with the loops of valarray_array.h: elements are
+  // addressed from the start, lengths and strides of the gslice, and
+  // its index array is never read.  The source of an assignment is
+  // read from element __k of the row on.
+  //
+  template<typename _Tp>
+    struct _GArray_fill
+    {
+      _Tp*       _M_data;
+      const _Tp& _M_t;
+
+      _GArray_fill(_Tp* __p, const _Tp& __t)
+      : _M_data(__p), _M_t(__t) {}
+
+      void
+      operator()(size_t __i, size_t, size_t __n, size_t __s) const
+      { std::__valarray_fill(_M_data + __i, __n, __s, _M_t); }
+    };
+
+  // __dst[<__k, __k + __n>] = __src[<__n : __s>] at __i; _Construct
+  // copy-constructs __dst instead.
+  template<typename _Tp, bool _Construct>
+    struct _GArray_gather
+    {
+      const _Tp* _M_src;
+      _Tp*       _M_dst;
+
+      _GArray_gather(const _Tp* __src, _Tp* __dst)
+      : _M_src(__src), _M_dst(__dst) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __n, size_t __s) const
+      {
+	if (_Construct)
+	  std::__valarray_copy_construct(_M_src + __i, __n, __s,
+					 _M_dst + __k);
+	else
+	  std::__valarray_copy(_M_src + __i, __n, __s, _M_dst + __k);
+      }
+    };
+
+  template<typename _Tp>
+    struct _GArray_scatter
+    {
+      _Tp*       _M_data;
+      const _Tp* _M_src;
+
+      _GArray_scatter(_Tp* __p, const _Tp* __src)
+      : _M_data(__p), _M_src(__src) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __n, size_t __s) const
+      { std::__valarray_copy(_M_src + __k, _M_data + __i, __n, __s); }
+    };
+
+  template<class _Dom, typename _Tp>
+    struct _GArray_scatter_expr
+    {
+      _Tp*                     _M_data;
+      const _Expr<_Dom, _Tp>&  _M_src;
+
+      _GArray_scatter_expr(_Tp* __p, const _Expr<_Dom, _Tp>& __e)
+      : _M_data(__p), _M_src(__e) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __n, size_t __s) const
+      {
+	_Tp* __p = _M_data + __i;
+	for (size_t __j = __k; __j < __k + __n; ++__j, __p += __s)
+	  *__p = _M_src[__j];
+      }
+    };
+
   template<typename _Tp>
     inline
     gslice_array<_Tp>::gslice_array(_Array<_Tp> __a,
-				    const valarray<size_t>& __i)
+				    const gslice::_Indexer& __i)
     : _M_array(__a), _M_index(__i) {}
 
   template<typename _Tp>
@@ -142,13 +222,25 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     gslice_array<_Tp>::gslice_array(const gslice_array<_Tp>& __a)
     : _M_array(__a._M_array), _M_index(__a._M_index) {}
 
+  template<typename _Tp>
+    template<class _Row>
+      inline void
+      gslice_array<_Tp>::_M_rows(_Row& __row) const
+      {
+	std::__valarray_gslice_rows(_M_index._M_start,
+				    _Array<size_t>(_M_index._M_size),
+				    _Array<size_t>(_M_index._M_stride),
+				    _M_index._M_size.size(), __row);
+      }
+
   template<typename _Tp>
     inline gslice_array<_Tp>&
     gslice_array<_Tp>::operator=(const gslice_array<_Tp>& __a)
     {
       std::__valarray_copy(_Array<_Tp>(__a._M_array),
-			   _Array<size_t>(__a._M_index), _M_index.size(),
-			   _M_array, _Array<size_t>(_M_index));
+			   _Array<size_t>(__a._M_index._M_index),
+			   _M_index._M_index.size(), _M_array,
+			   _Array<size_t>(_M_index._M_index));
       return *this;
     }
 
@@ -156,16 +248,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     inline void
     gslice_array<_Tp>::operator=(const _Tp& __t) const
     {
-      std::__valarray_fill(_M_array, _Array<size_t>(_M_index),
-			   _M_index.size(), __t);
+      _GArray_fill<_Tp> __row(_M_array._M_data, __t);
+      _M_rows(__row);
     }
 
   template<typename _Tp>
     inline void
     gslice_array<_Tp>::operator=(const valarray<_Tp>& __v) const
     {
-      std::__valarray_copy(_Array<_Tp>(__v), __v.size(),
-			   _M_array, _Array<size_t>(_M_index));
+      _GArray_scatter<_Tp> __row(_M_array._M_data, _Array<_Tp>(__v)._M_data);
+      _M_rows(__row);
     }
 
   template<typename _Tp>
@@ -173,18 +265,55 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       inline void
       gslice_array<_Tp>::operator=(const _Expr<_Dom, _Tp>& __e) const
       {
-	std::__valarray_copy (__e, _M_index.size(), _M_array,
-			      _Array<size_t>(_M_index));
+	_GArray_scatter_expr<_Dom, _Tp> __row(_M_array._M_data, __e);
+	_M_rows(__row);
       }
 
 #undef _DEFINE_VALARRAY_OPERATOR
 #define _DEFINE_VALARRAY_OPERATOR(_Op, _Name)				\
+  template<typename _Tp>						\
+    struct _GArray_augmented_##_Name					\
+    {									\
+      _Tp* _M_data;							\
+      _Tp* _M_src;							\
+									\
+      _GArray_augmented_##_Name(_Tp* __p, _Tp* __src)			\
+      : _M_data(__p), _M_src(__src) {}					\
+									\
+      void								\
+      operator()(size_t __i, size_t __k, size_t __n, size_t __s) const	\
+      {									\
+	_Array_augmented_##_Name(_Array<_Tp>(_M_data + __i), __n, __s,	\
+				 _Array<_Tp>(_M_src + __k));		\
+      }									\
+    };									\
+									\
+  template<class _Dom, typename _Tp>					\
+    struct _GArray_augmented_expr_##_Name				\
+    {									\
+      _Tp*                     _M_data;					\
+      const _Expr<_Dom, _Tp>&  _M_src;					\
+									\
+      _GArray_augmented_expr_##_Name(_Tp* __p,				\
+				     const _Expr<_Dom, _Tp>& __e)	\
+      : _M_data(__p), _M_src(__e) {}					\
+									\
+      void								\
+      operator()(size_t __i, size_t __k, size_t __n, size_t __s) const	\
+      {									\
+	_Tp* __p = _M_data + __i;					\
+	for (size_t __j = __k; __j < __k + __n; ++__j, __p += __s)	\
+	  *__p _Op##= _M_src[__j];					\
+      }									\
+    };									\
+									\
   template<typename _Tp>						\
     inline void								\
     gslice_array<_Tp>::operator _Op##=(const valarray<_Tp>& __v) const	\
     {									\
-      _Array_augmented_##_Name(_M_array, _Array<size_t>(_M_index),	\
-			       _Array<_Tp>(__v), __v.size());		\
+      _GArray_augmented_##_Name<_Tp> __row(_M_array._M_data,		\
+					   _Array<_Tp>(__v)._M_data);	\
+      _M_rows(__row);							\
     }									\
 									\
   template<typename _Tp>                                                \
@@ -192,8 +321,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       inline void							\
       gslice_array<_Tp>::operator _Op##= (const _Expr<_Dom, _Tp>& __e) const\
       {									\
-	_Array_augmented_##_Name(_M_array, _Array<size_t>(_M_index), __e,\
-				 _M_index.size());			\
+	_GArray_augmented_expr_##_Name<_Dom, _Tp> __row(_M_array._M_data,\
+							__e);		\
+	_M_rows(__row);							\
       }
 
 _DEFINE_VALARRAY_OPERATOR(*, __multiplies)
@@ -47,9 +47,12 @@ typedef pthread_key_t __gthread_key_t;
 typedef pthread_once_t __gthread_once_t;
 typedef pthread_mutex_t __gthread_mutex_t;
 typedef pthread_mutex_t __gthread_recursive_mutex_t;
+typedef pthread_t __gthread_t;
+typedef pthread_cond_t __gthread_cond_t;
 
 #define __GTHREAD_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
 #define __GTHREAD_ONCE_INIT PTHREAD_ONCE_INIT
+#define __GTHREAD_COND_INIT PTHREAD_COND_INITIALIZER
 #if defined(PTHREAD_RECURSIVE_MUTEX_INITIALIZER)
 #define __GTHREAD_RECURSIVE_MUTEX_INIT PTHREAD_RECURSIVE_MUTEX_INITIALIZER
 #elif defined(PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP)
@@ -105,6 +108,12 @@ __gthrw(pthread_key_delete)
 __gthrw(pthread_mutexattr_init)
 __gthrw(pthread_mutexattr_settype)
 __gthrw(pthread_mutexattr_destroy)
+__gthrw(pthread_detach)
+
+#if !defined(_LIBOBJC) && !defined(_LIBOBJC_WEAK)
+__gthrw(pthread_cond_broadcast)
+__gthrw(pthread_cond_wait)
+#endif
 
 
 #if defined(_LIBOBJC) || defined(_LIBOBJC_WEAK)
@@ -568,6 +577,34 @@ __gthread_objc_condition_signal (objc_condition_t condition)
 
 #else /* _LIBOBJC */
 
+/* Threads and condition variables, for the worker pool of the
+   parallel algorithms in ext/.  */
+#define __GTHREAD_HAS_COND 1
+
+static inline int
+__gthread_create (__gthread_t *thread, void *(*func) (void *), void *args)
+{
+  return __gthrw_(pthread_create) (thread, NULL, func, args);
+}
+
+static inline int
+__gthread_detach (__gthread_t thread)
+{
+  return __gthrw_(pthread_detach) (thread);
+}
+
+static inline int
+__gthread_cond_broadcast (__gthread_cond_t *cond)
+{
+  return __gthrw_(pthread_cond_broadcast) (cond);
+}
+
+static inline int
+__gthread_cond_wait (__gthread_cond_t *cond, __gthread_mutex_t *mutex)
+{
+  return __gthrw_(pthread_cond_wait) (cond, mutex);
+}
+
 static inline int
 __gthread_once (__gthread_once_t *once, void (*func) (void))
 {
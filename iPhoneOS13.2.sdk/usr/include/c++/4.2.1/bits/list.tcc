@@ -265,6 +265,58 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
 	  }
       }
 
+  // Lists shorter than this are sorted by splicing, without asking for
+  // a temporary array.
+  enum { _S_list_array_sort_threshold = 32 };
+
+  template<typename _Tp, typename _Alloc>
+    template <typename _NodeCompare>
+      bool
+      list<_Tp, _Alloc>::
+      _M_sort_nodes(_NodeCompare __comp)
+      {
+	_List_node_base* const __head = &this->_M_impl._M_node;
+	ptrdiff_t __n = 0;
+	for (_List_node_base* __cur = __head->_M_next; __cur != __head;
+	     __cur = __cur->_M_next)
+	  ++__n;
+	if (__n < _S_list_array_sort_threshold)
+	  return false;
+
+	// The first half holds the nodes, the second is merge scratch.
+	_List_node_base** const __nodes = static_cast<_List_node_base**>
+	  (::operator new(2 * __n * sizeof(_List_node_base*), std::nothrow));
+	if (!__nodes)
+	  return false;
+
+	_List_node_base* __cur = __head->_M_next;
+	for (ptrdiff_t __i = 0; __i < __n; ++__i, __cur = __cur->_M_next)
+	  __nodes[__i] = __cur;
+
+	try
+	  { std::__merge_sort_with_buffer(__nodes, __nodes + __n,
+					  __nodes + __n, __comp); }
+	catch(...)
+	  {
+	    // No link has been touched yet.
+	    ::operator delete(__nodes);
+	    __throw_exception_again;
+	  }
+
+	_List_node_base* __prev = __head;
+	for (ptrdiff_t __i = 0; __i < __n; ++__i)
+	  {
+	    __prev->_M_next = __nodes[__i];
+	    __nodes[__i]->_M_prev = __prev;
+	    __prev = __nodes[__i];
+	  }
+	__prev->_M_next = __head;
+	__head->_M_prev = __prev;
+
+	::operator delete(__nodes);
+	return true;
+      }
+
   template<typename _Tp, typename _Alloc>
     void
     list<_Tp, _Alloc>::
@@ -272,7 +324,8 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
     {
       // Do nothing if the list has length 0 or 1.
       if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
+	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node
+	  && !_M_sort_nodes(_List_node_less<_Tp>()))
       {
         list __carry;
         list __tmp[64];
@@ -349,7 +402,9 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
       {
 	// Do nothing if the list has length 0 or 1.
 	if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
+	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node
+	    && !_M_sort_nodes(_List_node_compare<_Tp,
+			      _StrictWeakOrdering>(__comp)))
 	  {
 	    list __carry;
 	    list __tmp[64];
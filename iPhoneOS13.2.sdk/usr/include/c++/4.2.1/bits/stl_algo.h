@@ -64,6 +64,7 @@
 
 #include <bits/stl_heap.h>
 #include <bits/stl_tempbuf.h>     // for _Temporary_buffer
+#include <bits/stl_merge_sort.h>
 #include <debug/debug.h>
 
 // See concept_check.h for the __glibcxx_*_requires macros.
@@ -137,6 +138,15 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	return __b;
     }
 
+  // operator< between two elements, which may differ in type.
+  struct __bound_less
+  {
+    template<typename _Tp1, typename _Tp2>
+      bool
+      operator()(const _Tp1& __x, const _Tp2& __y) const
+      { return __x < __y; }
+  };
+
   /**
    *  @brief Apply a function to every element of a sequence.
    *  @param  first  An input iterator.
@@ -294,6 +304,59 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	}
     }
 
+  /**
+   *  @if maint
+   *  Chooses between the generic find() and the vector kernel, which
+   *  handles contiguous ranges of arithmetic type searched for a value
+   *  of the same type.
+   *  @endif
+  */
+  template<bool>
+    struct __find_simd
+    {
+      template<typename _InputIterator, typename _Tp>
+        static _InputIterator
+        __find(_InputIterator __first, _InputIterator __last,
+	       const _Tp& __val)
+        { return std::__find(__first, __last, __val,
+			     std::__iterator_category(__first)); }
+
+      template<typename _InputIterator, typename _Tp>
+        static typename iterator_traits<_InputIterator>::difference_type
+        __count(_InputIterator __first, _InputIterator __last,
+		const _Tp& __value)
+        {
+	  typename iterator_traits<_InputIterator>::difference_type __n = 0;
+	  for ( ; __first != __last; ++__first)
+	    if (*__first == __value)
+	      ++__n;
+	  return __n;
+	}
+    };
+
+  template<>
+    struct __find_simd<true>
+    {
+      template<typename _Iterator, typename _Tp>
+        static _Iterator
+        __find(_Iterator __first, _Iterator __last, const _Tp& __val)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  return __first + (std::__simd_find(_Iter::_S_base(__first),
+					     _Iter::_S_base(__last), __val)
+			    - _Iter::_S_base(__first));
+	}
+
+      template<typename _Iterator, typename _Tp>
+        static typename iterator_traits<_Iterator>::difference_type
+        __count(_Iterator __first, _Iterator __last, const _Tp& __value)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  return std::__simd_count(_Iter::_S_base(__first),
+				   _Iter::_S_base(__last), __value);
+	}
+    };
+
   /**
    *  @if maint
    *  This is an overload of find() for streambuf iterators.
@@ -323,8 +386,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_EqualOpConcept<
 		typename iterator_traits<_InputIterator>::value_type, _Tp>)
       __glibcxx_requires_valid_range(__first, __last);
-      return std::__find(__first, __last, __val,
-		         std::__iterator_category(__first));
+      typedef typename iterator_traits<_InputIterator>::value_type _ValueType;
+      const bool __simd = (__simd_iter<_InputIterator>::__value
+			   && __are_same<_ValueType, _Tp>::__value);
+      return std::__find_simd<__simd>::__find(__first, __last, __val);
     }
 
   /**
@@ -428,11 +493,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_EqualOpConcept<
 	typename iterator_traits<_InputIterator>::value_type, _Tp>)
       __glibcxx_requires_valid_range(__first, __last);
-      typename iterator_traits<_InputIterator>::difference_type __n = 0;
-      for ( ; __first != __last; ++__first)
-	if (*__first == __value)
-	  ++__n;
-      return __n;
+      typedef typename iterator_traits<_InputIterator>::value_type _ValueType;
+      const bool __simd = (__simd_iter<_InputIterator>::__value
+			   && __are_same<_ValueType, _Tp>::__value);
+      return std::__find_simd<__simd>::__count(__first, __last, __value);
     }
 
   /**
@@ -459,6 +523,281 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return __n;
     }
 
+  /**
+   *  @if maint
+   *  A pattern of bytes prepared for the two-way string matching of
+   *  Crochemore and Perrin.  The pattern is split at a critical
+   *  factorization; the part right of the split is compared first, left
+   *  to right, and the left part after it.  A mismatch then allows a
+   *  shift that cannot skip an occurrence, and the search makes at most
+   *  about 2n comparisons whatever the input.  A table of the last
+   *  position of each byte value in the pattern adds Horspool's shift
+   *  on the byte under the pattern's end, which skips most of the
+   *  haystack for typical text.  The pattern is not copied and must
+   *  outlive the object.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator>
+    class __two_way_pattern
+    {
+      typedef typename iterator_traits<_RandomAccessIterator>::
+	difference_type _DistanceType;
+
+      _RandomAccessIterator _M_first;
+      _DistanceType         _M_len;
+      _DistanceType         _M_split;   // first element of the right part
+      _DistanceType         _M_period;  // shift after a full match
+      _DistanceType         _M_memory;  // prefix known to match after it
+      _DistanceType         _M_shift[256]; // last position + 1, or 0
+
+      template<typename _Tp>
+        static unsigned char
+        _S_byte(const _Tp& __c)
+        { return static_cast<unsigned char>(__c); }
+
+      // The start of the maximal suffix of the pattern for the byte
+      // order, or for the reverse order, minus one; and its period.
+      _DistanceType
+      _M_maximal_suffix(bool __reverse, _DistanceType& __period) const
+      {
+	_DistanceType __i = -1;
+	_DistanceType __j = 0;
+	_DistanceType __k = 1;
+	__period = 1;
+	while (__j + __k < _M_len)
+	  {
+	    const unsigned char __a = _S_byte(_M_first[__i + __k]);
+	    const unsigned char __b = _S_byte(_M_first[__j + __k]);
+	    if (__a == __b)
+	      {
+		if (__k == __period)
+		  {
+		    __j += __period;
+		    __k = 1;
+		  }
+		else
+		  ++__k;
+	      }
+	    else if (__reverse ? __a < __b : __b < __a)
+	      {
+		__j += __k;
+		__k = 1;
+		__period = __j - __i;
+	      }
+	    else
+	      {
+		__i = __j++;
+		__k = __period = 1;
+	      }
+	  }
+	return __i;
+      }
+
+    public:
+      __two_way_pattern(_RandomAccessIterator __first,
+			_RandomAccessIterator __last)
+      : _M_first(__first), _M_len(__last - __first), _M_memory(0)
+      {
+	for (int __c = 0; __c < 256; ++__c)
+	  _M_shift[__c] = 0;
+	for (_DistanceType __i = 0; __i < _M_len; ++__i)
+	  _M_shift[_S_byte(__first[__i])] = __i + 1;
+
+	_DistanceType __period;
+	_DistanceType __reverse_period;
+	_DistanceType __suffix = _M_maximal_suffix(false, __period);
+	const _DistanceType __reverse_suffix =
+	  _M_maximal_suffix(true, __reverse_period);
+	if (__reverse_suffix > __suffix)
+	  {
+	    __suffix = __reverse_suffix;
+	    __period = __reverse_period;
+	  }
+	_M_split = __suffix + 1;
+
+	if (_M_len > 0 && std::equal(__first, __first + _M_split,
+				     __first + __period))
+	  {
+	    // Periodic: after a match, the next period's worth of
+	    // elements is all that remains to be compared.
+	    _M_period = __period;
+	    _M_memory = _M_len - __period;
+	  }
+	else
+	  _M_period = std::max(__suffix, _M_len - __suffix - 1) + 1;
+      }
+
+      _RandomAccessIterator
+      _M_begin() const
+      { return _M_first; }
+
+      _RandomAccessIterator
+      _M_end() const
+      { return _M_first + _M_len; }
+
+      // The first occurrence of the pattern in [first, last), or last.
+      template<typename _RandomAccessIterator1>
+        _RandomAccessIterator1
+        _M_find(_RandomAccessIterator1 __first,
+		_RandomAccessIterator1 __last) const
+        {
+	  const _DistanceType __len = _M_len;
+	  _DistanceType __memory = 0;
+	  while (__last - __first >= __len)
+	    {
+	      if (__len == 0)
+		return __first;
+
+	      _DistanceType __k = __len - _M_shift[_S_byte(__first[__len - 1])];
+	      if (__k != 0)
+		{
+		  __first += std::max(__k, __memory);
+		  __memory = 0;
+		  continue;
+		}
+
+	      __k = std::max(_M_split, __memory);
+	      while (__k < __len && _M_first[__k] == __first[__k])
+		++__k;
+	      if (__k < __len)
+		{
+		  __first += __k - _M_split + 1;
+		  __memory = 0;
+		  continue;
+		}
+
+	      __k = _M_split;
+	      while (__k > __memory && _M_first[__k - 1] == __first[__k - 1])
+		--__k;
+	      if (__k <= __memory)
+		return __first;
+	      __first += _M_period;
+	      __memory = _M_memory;
+	    }
+	  return __last;
+	}
+    };
+
+  /**
+   *  @if maint
+   *  The general case of search(), for patterns of two elements or
+   *  more.  The primary template tries each occurrence of the first
+   *  element of the pattern in turn.  The specialization handles random
+   *  access ranges of the same byte type: short patterns in contiguous
+   *  storage go to the vector kernel, and long haystacks to the two-way
+   *  search.
+   *  @endif
+  */
+  template<bool>
+    struct __search_bytes
+    {
+      template<typename _ForwardIterator1, typename _ForwardIterator2>
+        static _ForwardIterator1
+        __search(_ForwardIterator1 __first1, _ForwardIterator1 __last1,
+		 _ForwardIterator2 __first2, _ForwardIterator2 __last2)
+        {
+	  _ForwardIterator2 __p1, __p;
+	  __p1 = __first2; ++__p1;
+	  _ForwardIterator1 __current = __first1;
+
+	  while (__first1 != __last1)
+	    {
+	      __first1 = std::find(__first1, __last1, *__first2);
+	      if (__first1 == __last1)
+		return __last1;
+
+	      __p = __p1;
+	      __current = __first1;
+	      if (++__current == __last1)
+		return __last1;
+
+	      while (*__current == *__p)
+		{
+		  if (++__p == __last2)
+		    return __first1;
+		  if (++__current == __last1)
+		    return __last1;
+		}
+	      ++__first1;
+	    }
+	  return __first1;
+	}
+    };
+
+  template<>
+    struct __search_bytes<true>
+    {
+      // Patterns up to this length use the vector kernel when they can.
+      enum { _S_short_pattern = 32 };
+
+      // Shorter haystacks are not worth building the two-way tables for.
+      enum { _S_short_haystack = 1024 };
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2>
+        static _RandomAccessIterator1
+        __search(_RandomAccessIterator1 __first1,
+		 _RandomAccessIterator1 __last1,
+		 _RandomAccessIterator2 __first2,
+		 _RandomAccessIterator2 __last2)
+        {
+	  const bool __simd = (__simd_iter<_RandomAccessIterator1>::__value
+			       && __simd_iter<_RandomAccessIterator2>::__value);
+	  if (__last2 - __first2 <= int(_S_short_pattern) && __simd)
+	    return _S_find_short(__first1, __last1, __first2, __last2,
+				 typename __truth_type<__simd>::__type());
+	  if (__last1 - __first1 < int(_S_short_haystack))
+	    return std::__search_bytes<false>::
+	      __search(__first1, __last1, __first2, __last2);
+
+	  const __two_way_pattern<_RandomAccessIterator2>
+	    __pattern(__first2, __last2);
+	  return __pattern._M_find(__first1, __last1);
+	}
+
+      // Searches for a prepared pattern of any length.
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2>
+        static _RandomAccessIterator1
+        _S_find(_RandomAccessIterator1 __first1,
+		_RandomAccessIterator1 __last1,
+		const __two_way_pattern<_RandomAccessIterator2>& __pattern)
+        {
+	  const bool __simd = (__simd_iter<_RandomAccessIterator1>::__value
+			       && __simd_iter<_RandomAccessIterator2>::__value);
+	  const _RandomAccessIterator2 __first2 = __pattern._M_begin();
+	  const _RandomAccessIterator2 __last2 = __pattern._M_end();
+	  if (__last2 - __first2 < 2)
+	    return (__first2 == __last2 || __first1 == __last1 ? __first1
+		    : std::find(__first1, __last1, *__first2));
+	  if (__last2 - __first2 <= int(_S_short_pattern) && __simd)
+	    return _S_find_short(__first1, __last1, __first2, __last2,
+				 typename __truth_type<__simd>::__type());
+	  return __pattern._M_find(__first1, __last1);
+	}
+
+    private:
+      template<typename _Iterator1, typename _Iterator2>
+        static _Iterator1
+        _S_find_short(_Iterator1 __first1, _Iterator1 __last1,
+		      _Iterator2 __first2, _Iterator2 __last2, __true_type)
+        {
+	  typedef __simd_iter<_Iterator1> _Iter1;
+	  typedef __simd_iter<_Iterator2> _Iter2;
+	  return __first1 + (std::__simd_search(_Iter1::_S_base(__first1),
+						_Iter1::_S_base(__last1),
+						_Iter2::_S_base(__first2),
+						_Iter2::_S_base(__last2))
+			     - _Iter1::_S_base(__first1));
+	}
+
+      template<typename _Iterator1, typename _Iterator2>
+        static _Iterator1
+        _S_find_short(_Iterator1 __first1, _Iterator1, _Iterator2,
+		      _Iterator2, __false_type)
+        { return __first1; }
+    };
+
   /**
    *  @brief Search a sequence for a matching sub-sequence.
    *  @param  first1  A forward iterator.
@@ -506,31 +845,19 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	return std::find(__first1, __last1, *__first2);
 
       // General case.
-      _ForwardIterator2 __p1, __p;
-      __p1 = __first2; ++__p1;
-      _ForwardIterator1 __current = __first1;
-
-      while (__first1 != __last1)
-	{
-	  __first1 = std::find(__first1, __last1, *__first2);
-	  if (__first1 == __last1)
-	    return __last1;
-
-	  __p = __p1;
-	  __current = __first1;
-	  if (++__current == __last1)
-	    return __last1;
-
-	  while (*__current == *__p)
-	    {
-	      if (++__p == __last2)
-		return __first1;
-	      if (++__current == __last1)
-		return __last1;
-	    }
-	  ++__first1;
-	}
-      return __first1;
+      typedef typename iterator_traits<_ForwardIterator1>::value_type
+	_ValueType1;
+      typedef typename iterator_traits<_ForwardIterator2>::value_type
+	_ValueType2;
+      const bool __bytes =
+	(__are_same<typename iterator_traits<_ForwardIterator1>::
+		    iterator_category, random_access_iterator_tag>::__value
+	 && __are_same<typename iterator_traits<_ForwardIterator2>::
+		       iterator_category, random_access_iterator_tag>::__value
+	 && __are_same<_ValueType1, _ValueType2>::__value
+	 && __is_integer<_ValueType1>::__value && sizeof(_ValueType1) == 1);
+      return std::__search_bytes<__bytes>::__search(__first1, __last1,
+						     __first2, __last2);
     }
 
   /**
@@ -870,6 +1197,66 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 			     std::__iterator_category(__first));
     }
 
+  /**
+   *  @if maint
+   *  The element loops of swap_ranges and reverse.  The specialization
+   *  for contiguous ranges of a vectorizable type moves whole vectors.
+   *  @endif
+   */
+  template<bool>
+    struct __swap_simd
+    {
+      template<typename _ForwardIterator1, typename _ForwardIterator2>
+        static _ForwardIterator2
+        __swap_ranges(_ForwardIterator1 __first1, _ForwardIterator1 __last1,
+		      _ForwardIterator2 __first2)
+        {
+	  for ( ; __first1 != __last1; ++__first1, ++__first2)
+	    std::iter_swap(__first1, __first2);
+	  return __first2;
+	}
+
+      template<typename _RandomAccessIterator>
+        static void
+        __reverse(_RandomAccessIterator __first, _RandomAccessIterator __last)
+        {
+	  if (__first == __last)
+	    return;
+	  --__last;
+	  while (__first < __last)
+	    {
+	      std::iter_swap(__first, __last);
+	      ++__first;
+	      --__last;
+	    }
+	}
+    };
+
+  template<>
+    struct __swap_simd<true>
+    {
+      template<typename _Iterator1, typename _Iterator2>
+        static _Iterator2
+        __swap_ranges(_Iterator1 __first1, _Iterator1 __last1,
+		      _Iterator2 __first2)
+        {
+	  typedef __simd_iter<_Iterator1> _Iter1;
+	  typedef __simd_iter<_Iterator2> _Iter2;
+	  return __first2 + (std::__simd_swap_ranges(_Iter1::_S_base(__first1),
+						     _Iter1::_S_base(__last1),
+						     _Iter2::_S_base(__first2))
+			     - _Iter2::_S_base(__first2));
+	}
+
+      template<typename _Iterator>
+        static void
+        __reverse(_Iterator __first, _Iterator __last)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  std::__simd_reverse(_Iter::_S_base(__first), _Iter::_S_base(__last));
+	}
+    };
+
   /**
    *  @brief Swap the elements of two sequences.
    *  @param  first1  A forward iterator.
@@ -899,9 +1286,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_ForwardIterator1>::value_type>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
-      for ( ; __first1 != __last1; ++__first1, ++__first2)
-	std::iter_swap(__first1, __first2);
-      return __first2;
+      const bool __simd = __simd_iter_pair<_ForwardIterator1,
+					   _ForwardIterator2>::__value;
+      return std::__swap_simd<__simd>::__swap_ranges(__first1, __last1,
+						      __first2);
     }
 
   /**
@@ -1160,6 +1548,242 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return __first;
     }
 
+  // Elements compacted per step into the stack buffer of the copying
+  // forms of __compress_simd<true>.
+  enum { _S_compress_chunk = 256 };
+
+  /**
+   *  @if maint
+   *  The loops of remove_copy, remove_copy_if, remove, remove_if and
+   *  unique.  The specialization for contiguous ranges of a vectorizable
+   *  type has no branch per element: each element is stored and the
+   *  output advanced by the result of its test, and where the test is
+   *  equality with a value or with the element before, a whole vector
+   *  is tested and packed at once.  The copying forms pack into a stack
+   *  buffer, then copy it to the result, which has no room for the
+   *  extra stores.
+   *  @endif
+   */
+  template<bool>
+    struct __compress_simd
+    {
+      template<typename _InputIterator, typename _OutputIterator,
+	       typename _Tp>
+        static _OutputIterator
+        __remove_copy(_InputIterator __first, _InputIterator __last,
+		      _OutputIterator __result, const _Tp& __value)
+        {
+	  for ( ; __first != __last; ++__first)
+	    if (!(*__first == __value))
+	      {
+		*__result = *__first;
+		++__result;
+	      }
+	  return __result;
+	}
+
+      template<typename _InputIterator, typename _OutputIterator,
+	       typename _Predicate>
+        static _OutputIterator
+        __remove_copy_if(_InputIterator __first, _InputIterator __last,
+			 _OutputIterator __result, _Predicate __pred)
+        {
+	  for ( ; __first != __last; ++__first)
+	    if (!__pred(*__first))
+	      {
+		*__result = *__first;
+		++__result;
+	      }
+	  return __result;
+	}
+
+      template<typename _ForwardIterator, typename _Tp>
+        static _ForwardIterator
+        __remove(_ForwardIterator __first, _ForwardIterator __last,
+		 const _Tp& __value)
+        {
+	  __first = std::find(__first, __last, __value);
+	  _ForwardIterator __i = __first;
+	  return __first == __last ? __first
+				   : __remove_copy(++__i, __last,
+						   __first, __value);
+	}
+
+      template<typename _ForwardIterator, typename _Predicate>
+        static _ForwardIterator
+        __remove_if(_ForwardIterator __first, _ForwardIterator __last,
+		    _Predicate __pred)
+        {
+	  __first = std::find_if(__first, __last, __pred);
+	  _ForwardIterator __i = __first;
+	  return __first == __last ? __first
+				   : __remove_copy_if(++__i, __last,
+						      __first, __pred);
+	}
+
+      template<typename _ForwardIterator>
+        static _ForwardIterator
+        __unique(_ForwardIterator __first, _ForwardIterator __last)
+        {
+	  // Skip the beginning, if already unique.
+	  __first = std::adjacent_find(__first, __last);
+	  if (__first == __last)
+	    return __last;
+
+	  // Do the real copy work.
+	  _ForwardIterator __dest = __first;
+	  ++__first;
+	  while (++__first != __last)
+	    if (!(*__dest == *__first))
+	      *++__dest = *__first;
+	  return ++__dest;
+	}
+    };
+
+  template<>
+    struct __compress_simd<true>
+    {
+      template<typename _InputIterator, typename _OutputIterator,
+	       typename _Tp>
+        static _OutputIterator
+        __remove_copy(_InputIterator __first, _InputIterator __last,
+		      _OutputIterator __result, const _Tp& __value)
+        {
+	  typedef __simd_iter<_InputIterator> _Iter;
+	  const _Tp* __p = _Iter::_S_base(__first);
+	  const _Tp* const __end = _Iter::_S_base(__last);
+	  _Tp __buf[_S_compress_chunk];
+	  while (__p != __end)
+	    {
+	      const ptrdiff_t __n = std::min(__end - __p,
+					     ptrdiff_t(_S_compress_chunk));
+	      __result = std::copy(__buf,
+				   std::__simd_remove_copy(__p, __p + __n,
+							   __buf, __value),
+				   __result);
+	      __p += __n;
+	    }
+	  return __result;
+	}
+
+      template<typename _InputIterator, typename _OutputIterator,
+	       typename _Predicate>
+        static _OutputIterator
+        __remove_copy_if(_InputIterator __first, _InputIterator __last,
+			 _OutputIterator __result, _Predicate __pred)
+        {
+	  // The predicate is called on the element itself, as it may take
+	  // it by non-const reference, and before the element is stored.
+	  typedef typename iterator_traits<_InputIterator>::value_type
+	    _ValueType;
+	  _ValueType __buf[_S_compress_chunk];
+	  while (__first != __last)
+	    {
+	      const _InputIterator __stop =
+		__first + std::min(__last - __first,
+				   ptrdiff_t(_S_compress_chunk));
+	      _ValueType* __out = __buf;
+	      for (; __first != __stop; ++__first)
+		{
+		  const bool __keep = !__pred(*__first);
+		  *__out = *__first;
+		  __out += __keep;
+		}
+	      __result = std::copy(__buf, __out, __result);
+	    }
+	  return __result;
+	}
+
+      template<typename _ForwardIterator, typename _Tp>
+        static _ForwardIterator
+        __remove(_ForwardIterator __first, _ForwardIterator __last,
+		 const _Tp& __value)
+        {
+	  __first = std::find(__first, __last, __value);
+	  if (__first == __last)
+	    return __first;
+
+	  typedef __simd_iter<_ForwardIterator> _Iter;
+	  _Tp* const __dest = _Iter::_S_base(__first);
+	  return __first + (std::__simd_remove_copy(__dest + 1,
+						    _Iter::_S_base(__last),
+						    __dest, __value)
+			    - __dest);
+	}
+
+      template<typename _ForwardIterator, typename _Predicate>
+        static _ForwardIterator
+        __remove_if(_ForwardIterator __first, _ForwardIterator __last,
+		    _Predicate __pred)
+        {
+	  __first = std::find_if(__first, __last, __pred);
+	  if (__first == __last)
+	    return __first;
+
+	  typedef __simd_iter<_ForwardIterator> _Iter;
+	  typedef typename iterator_traits<_ForwardIterator>::value_type
+	    _ValueType;
+	  _ValueType* const __dest = _Iter::_S_base(__first);
+	  _ValueType* const __end = _Iter::_S_base(__last);
+	  _ValueType* __out = __dest;
+	  for (_ValueType* __p = __dest + 1; __p != __end; ++__p)
+	    {
+	      const bool __keep = !__pred(*__p);
+	      *__out = *__p;
+	      __out += __keep;
+	    }
+	  return __first + (__out - __dest);
+	}
+
+      template<typename _ForwardIterator>
+        static _ForwardIterator
+        __unique(_ForwardIterator __first, _ForwardIterator __last)
+        {
+	  __first = std::adjacent_find(__first, __last);
+	  if (__first == __last)
+	    return __last;
+
+	  // *__dest is kept, and its duplicate dest[1] overwritten.
+	  typedef __simd_iter<_ForwardIterator> _Iter;
+	  typedef typename iterator_traits<_ForwardIterator>::value_type
+	    _ValueType;
+	  _ValueType* const __dest = _Iter::_S_base(__first);
+	  return __first + (std::__simd_unique_copy(__dest + 2,
+						    _Iter::_S_base(__last),
+						    __dest + 1)
+			    - __dest);
+	}
+
+      // As unique_copy, for a non-empty range.
+      template<typename _InputIterator, typename _OutputIterator>
+        static _OutputIterator
+        __unique_copy(_InputIterator __first, _InputIterator __last,
+		      _OutputIterator __result)
+        {
+	  typedef __simd_iter<_InputIterator> _Iter;
+	  typedef typename iterator_traits<_InputIterator>::value_type
+	    _ValueType;
+	  const _ValueType* __p = _Iter::_S_base(__first);
+	  const _ValueType* const __end = _Iter::_S_base(__last);
+	  *__result = *__p;
+	  ++__result;
+	  ++__p;
+
+	  _ValueType __buf[_S_compress_chunk];
+	  while (__p != __end)
+	    {
+	      const ptrdiff_t __n = std::min(__end - __p,
+					     ptrdiff_t(_S_compress_chunk));
+	      __result = std::copy(__buf,
+				   std::__simd_unique_copy(__p, __p + __n,
+							   __buf),
+				   __result);
+	      __p += __n;
+	    }
+	  return __result;
+	}
+    };
+
   /**
    *  @brief Copy a sequence, removing elements of a given value.
    *  @param  first   An input iterator.
@@ -1186,13 +1810,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_InputIterator>::value_type, _Tp>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      for ( ; __first != __last; ++__first)
-	if (!(*__first == __value))
-	  {
-	    *__result = *__first;
-	    ++__result;
-	  }
-      return __result;
+      const bool __simd = (__simd_iter<_InputIterator>::__value
+			   && __are_same<typename iterator_traits<
+					   _InputIterator>::value_type,
+					 _Tp>::__value);
+      return std::__compress_simd<__simd>::__remove_copy(__first, __last,
+							 __result, __value);
     }
 
   /**
@@ -1223,13 +1846,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_InputIterator>::value_type>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      for ( ; __first != __last; ++__first)
-	if (!__pred(*__first))
-	  {
-	    *__result = *__first;
-	    ++__result;
-	  }
-      return __result;
+      return std::__compress_simd<__simd_iter<_InputIterator>::__value>::
+	__remove_copy_if(__first, __last, __result, __pred);
     }
 
   /**
@@ -1260,11 +1878,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_ForwardIterator>::value_type, _Tp>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      __first = std::find(__first, __last, __value);
-      _ForwardIterator __i = __first;
-      return __first == __last ? __first
-			       : std::remove_copy(++__i, __last,
-						  __first, __value);
+      const bool __simd = (__simd_iter<_ForwardIterator>::__value
+			   && __are_same<typename iterator_traits<
+					   _ForwardIterator>::value_type,
+					 _Tp>::__value);
+      return std::__compress_simd<__simd>::__remove(__first, __last, __value);
     }
 
   /**
@@ -1295,11 +1913,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_ForwardIterator>::value_type>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      __first = std::find_if(__first, __last, __pred);
-      _ForwardIterator __i = __first;
-      return __first == __last ? __first
-			       : std::remove_copy_if(++__i, __last,
-						     __first, __pred);
+      return std::__compress_simd<__simd_iter<_ForwardIterator>::__value>::
+	__remove_if(__first, __last, __pred);
     }
 
   /**
@@ -1462,6 +2077,28 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return ++__result;
     }
 
+  // unique_copy of a non-empty range: with the compaction kernel when
+  // the input is contiguous storage of a vectorizable type, otherwise
+  // with the loops above.
+  template<typename _InputIterator, typename _OutputIterator>
+    inline _OutputIterator
+    __unique_copy(_InputIterator __first, _InputIterator __last,
+		  _OutputIterator __result, __true_type)
+    {
+      return std::__compress_simd<true>::__unique_copy(__first, __last,
+						       __result);
+    }
+
+  template<typename _InputIterator, typename _OutputIterator>
+    inline _OutputIterator
+    __unique_copy(_InputIterator __first, _InputIterator __last,
+		  _OutputIterator __result, __false_type)
+    {
+      return std::__unique_copy(__first, __last, __result,
+				std::__iterator_category(__first),
+				std::__iterator_category(__result));
+    }
+
   /**
    *  @brief Copy a sequence, removing consecutive duplicate values.
    *  @param  first   An input iterator.
@@ -1499,9 +2136,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 
       if (__first == __last)
 	return __result;
-      return std::__unique_copy(__first, __last, __result,
-				std::__iterator_category(__first),
-				std::__iterator_category(__result));
+      typedef typename __truth_type<__simd_iter<_InputIterator>::__value>::
+	__type _Simd;
+      return std::__unique_copy(__first, __last, __result, _Simd());
     }
 
   /**
@@ -1568,18 +2205,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 		     typename iterator_traits<_ForwardIterator>::value_type>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      // Skip the beginning, if already unique.
-      __first = std::adjacent_find(__first, __last);
-      if (__first == __last)
-	return __last;
-
-      // Do the real copy work.
-      _ForwardIterator __dest = __first;
-      ++__first;
-      while (++__first != __last)
-	if (!(*__dest == *__first))
-	  *++__dest = *__first;
-      return ++__dest;
+      return std::__compress_simd<__simd_iter<_ForwardIterator>::__value>::
+	__unique(__first, __last);
     }
 
   /**
@@ -1657,15 +2284,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __reverse(_RandomAccessIterator __first, _RandomAccessIterator __last,
 	      random_access_iterator_tag)
     {
-      if (__first == __last)
-	return;
-      --__last;
-      while (__first < __last)
-	{
-	  std::iter_swap(__first, __last);
-	  ++__first;
-	  --__last;
-	}
+      std::__swap_simd<__simd_iter<_RandomAccessIterator>::__value>::
+	__reverse(__first, __last);
     }
 
   /**
@@ -1820,6 +2440,85 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	std::__reverse(__first,  __middle, bidirectional_iterator_tag());
     }
 
+  // Largest shorter side, in bytes, that __rotate_trivial moves through
+  // a stack buffer.
+  enum { _S_rotate_buffer = 512 };
+
+  /**
+   *  @if maint
+   *  rotate for contiguous storage of a POD type.  When the shorter side
+   *  fits in a stack buffer it is set aside there while memmove shifts
+   *  the longer one.  Otherwise the shorter side is swapped into its
+   *  final place with the block at the far end of the longer one, which
+   *  leaves a rotation of what remains (Gries and Mills' block swap),
+   *  until the shorter side fits.
+   *  @endif
+  */
+  template<typename _Tp>
+    void
+    __rotate_trivial(_Tp* __first, _Tp* __middle, _Tp* __last)
+    {
+      enum { _S_len = (_S_rotate_buffer + sizeof(_Tp) - 1) / sizeof(_Tp) };
+      _Tp __buf[_S_len];
+
+      for (;;)
+	{
+	  const ptrdiff_t __k = __middle - __first;
+	  const ptrdiff_t __l = __last - __middle;
+	  if (__k == 0 || __l == 0)
+	    return;
+
+	  if (__k <= __l)
+	    {
+	      if (__k <= _S_len)
+		{
+		  std::memcpy(__buf, __first, sizeof(_Tp) * __k);
+		  std::memmove(__first, __middle, sizeof(_Tp) * __l);
+		  std::memcpy(__first + __l, __buf, sizeof(_Tp) * __k);
+		  return;
+		}
+	      std::swap_ranges(__first, __middle, __middle);
+	      __first = __middle;
+	      __middle += __k;
+	    }
+	  else
+	    {
+	      if (__l <= _S_len)
+		{
+		  std::memcpy(__buf, __middle, sizeof(_Tp) * __l);
+		  std::memmove(__last - __k, __first, sizeof(_Tp) * __k);
+		  std::memcpy(__first, __buf, sizeof(_Tp) * __l);
+		  return;
+		}
+	      std::swap_ranges(__middle - __l, __middle, __middle);
+	      __last = __middle;
+	      __middle -= __l;
+	    }
+	}
+    }
+
+  // Runs __rotate_trivial on the storage under a pointer or a
+  // __normal_iterator, and returns true; the __false_type overload
+  // leaves the rotation to the caller.
+  template<typename _RandomAccessIterator>
+    inline bool
+    __rotate_trivial(_RandomAccessIterator __first,
+		     _RandomAccessIterator __middle,
+		     _RandomAccessIterator __last, __true_type)
+    {
+      typename iterator_traits<_RandomAccessIterator>::value_type* const
+	__p = &*__first;
+      std::__rotate_trivial(__p, __p + (__middle - __first),
+			    __p + (__last - __first));
+      return true;
+    }
+
+  template<typename _RandomAccessIterator>
+    inline bool
+    __rotate_trivial(_RandomAccessIterator, _RandomAccessIterator,
+		     _RandomAccessIterator, __false_type)
+    { return false; }
+
   /**
    *  @if maint
    *  This is a helper function for the rotate algorithm.
@@ -1844,6 +2543,14 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       typedef typename iterator_traits<_RandomAccessIterator>::value_type
 	_ValueType;
 
+      const bool __trivial =
+	(__is_pod<_ValueType>::__value
+	 && (__is_pointer<_RandomAccessIterator>::__value
+	     || __is_normal_iterator<_RandomAccessIterator>::__value));
+      if (std::__rotate_trivial(__first, __middle, __last,
+				typename __truth_type<__trivial>::__type()))
+	return;
+
       const _Distance __n = __last   - __first;
       const _Distance __k = __middle - __first;
       const _Distance __l = __n - __k;
@@ -1996,22 +2703,50 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
    *  Reorders the elements in the range @p [first,last) using @p rand to
    *  provide a random distribution. Calling @p rand(N) for a positive
    *  integer @p N should return a randomly chosen integer from the
-   *  range [0,N).
+   *  range [0,N).  A std::tr1::variate_generator pairing an engine with
+   *  a std::tr1::uniform_int makes a fast and unbiased @p rand.
+   *
+   *  The positions to swap with are drawn a few elements ahead of the
+   *  swaps themselves and prefetched, so that on sequences larger than
+   *  the cache the misses overlap.  @p rand is still called with 2, 3,
+   *  ..., N in that order.
   */
   template<typename _RandomAccessIterator, typename _RandomNumberGenerator>
     void
     random_shuffle(_RandomAccessIterator __first, _RandomAccessIterator __last,
 		   _RandomNumberGenerator& __rand)
     {
-      // concept requirements
-      __glibcxx_function_requires(_Mutable_RandomAccessIteratorConcept<
+      typedef typename iterator_traits<_RandomAccessIterator>::difference_type
+	_Distance;
+
+      // concept requirements
+      __glibcxx_function_requires(_Mutable_RandomAccessIteratorConcept<
 	    _RandomAccessIterator>)
       __glibcxx_requires_valid_range(__first, __last);
 
       if (__first == __last)
 	return;
-      for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
-	std::iter_swap(__i, __first + __rand((__i - __first) + 1));
+
+      enum { _S_ahead = 16 };
+      _Distance __j[_S_ahead];
+      const _Distance __len = __last - __first;
+      _Distance __i;
+      for (__i = 1; __i < __len && __i <= _Distance(_S_ahead); ++__i)
+	{
+	  __j[__i - 1] = __rand(__i + 1);
+	  std::__iter_prefetch(__first + __j[__i - 1]);
+	}
+      for (__i = 1; __i < __len; ++__i)
+	{
+	  _Distance& __slot = __j[(__i - 1) % _S_ahead];
+	  const _Distance __cur = __slot;
+	  if (__i + _S_ahead < __len)
+	    {
+	      __slot = __rand(__i + _S_ahead + 1);
+	      std::__iter_prefetch(__first + __slot);
+	    }
+	  std::iter_swap(__first + __i, __first + __cur);
+	}
     }
 
 
@@ -2295,100 +3030,6 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   */
   enum { _S_threshold = 16 };
 
-  /**
-   *  @if maint
-   *  This is a helper function for the sort routine.
-   *  @endif
-  */
-  template<typename _RandomAccessIterator, typename _Tp>
-    void
-    __unguarded_linear_insert(_RandomAccessIterator __last, _Tp __val)
-    {
-      _RandomAccessIterator __next = __last;
-      --__next;
-      while (__val < *__next)
-	{
-	  *__last = *__next;
-	  __last = __next;
-	  --__next;
-	}
-      *__last = __val;
-    }
-
-  /**
-   *  @if maint
-   *  This is a helper function for the sort routine.
-   *  @endif
-  */
-  template<typename _RandomAccessIterator, typename _Tp, typename _Compare>
-    void
-    __unguarded_linear_insert(_RandomAccessIterator __last, _Tp __val,
-			      _Compare __comp)
-    {
-      _RandomAccessIterator __next = __last;
-      --__next;
-      while (__comp(__val, *__next))
-	{
-	  *__last = *__next;
-	  __last = __next;
-	  --__next;
-	}
-      *__last = __val;
-    }
-
-  /**
-   *  @if maint
-   *  This is a helper function for the sort routine.
-   *  @endif
-  */
-  template<typename _RandomAccessIterator>
-    void
-    __insertion_sort(_RandomAccessIterator __first,
-		     _RandomAccessIterator __last)
-    {
-      if (__first == __last)
-	return;
-
-      for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
-	{
-	  typename iterator_traits<_RandomAccessIterator>::value_type
-	    __val = *__i;
-	  if (__val < *__first)
-	    {
-	      std::copy_backward(__first, __i, __i + 1);
-	      *__first = __val;
-	    }
-	  else
-	    std::__unguarded_linear_insert(__i, __val);
-	}
-    }
-
-  /**
-   *  @if maint
-   *  This is a helper function for the sort routine.
-   *  @endif
-  */
-  template<typename _RandomAccessIterator, typename _Compare>
-    void
-    __insertion_sort(_RandomAccessIterator __first,
-		     _RandomAccessIterator __last, _Compare __comp)
-    {
-      if (__first == __last) return;
-
-      for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
-	{
-	  typename iterator_traits<_RandomAccessIterator>::value_type
-	    __val = *__i;
-	  if (__comp(__val, *__first))
-	    {
-	      std::copy_backward(__first, __i, __i + 1);
-	      *__first = __val;
-	    }
-	  else
-	    std::__unguarded_linear_insert(__i, __val, __comp);
-	}
-    }
-
   /**
    *  @if maint
    *  This is a helper function for the sort routine.
@@ -2462,6 +3103,103 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	std::__insertion_sort(__first, __last, __comp);
     }
 
+  /**
+   *  @if maint
+   *  The scans of __heap_select and partial_sort_copy, which look for
+   *  the elements that are less than the top of the heap.  With a
+   *  contiguous range of arithmetic type the specialization compares a
+   *  vector of elements with the top at a time.
+   *  @endif
+  */
+  template<bool>
+    struct __heap_select_simd
+    {
+      template<typename _RandomAccessIterator>
+        static void
+        __select(_RandomAccessIterator __first,
+		 _RandomAccessIterator __middle,
+		 _RandomAccessIterator __last)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::value_type
+	    _ValueType;
+
+	  for (_RandomAccessIterator __i = __middle; __i < __last; ++__i)
+	    if (*__i < *__first)
+	      std::__pop_heap(__first, __middle, __i, _ValueType(*__i));
+	}
+
+      template<typename _InputIterator, typename _RandomAccessIterator>
+        static void
+        __select_copy(_InputIterator __first, _InputIterator __last,
+		      _RandomAccessIterator __result_first,
+		      _RandomAccessIterator __result_last)
+        {
+	  typedef typename iterator_traits<_InputIterator>::value_type
+	    _InputValueType;
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  for (; __first != __last; ++__first)
+	    if (*__first < *__result_first)
+	      std::__adjust_heap(__result_first, _DistanceType(0),
+				 _DistanceType(__result_last
+					       - __result_first),
+				 _InputValueType(*__first));
+	}
+    };
+
+  template<>
+    struct __heap_select_simd<true>
+    {
+      template<typename _RandomAccessIterator>
+        static void
+        __select(_RandomAccessIterator __first,
+		 _RandomAccessIterator __middle,
+		 _RandomAccessIterator __last)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::value_type
+	    _ValueType;
+	  typedef __simd_iter<_RandomAccessIterator> _Iter;
+
+	  if (__first == __middle)
+	    return;
+	  const _ValueType* const __end = _Iter::_S_base(__last);
+	  for (const _ValueType* __i = _Iter::_S_base(__middle);; ++__i)
+	    {
+	      __i = std::__simd_find_less(__i, __end, *__first);
+	      if (__i == __end)
+		break;
+	      std::__pop_heap(__first, __middle, __last - (__end - __i),
+			      _ValueType(*__i));
+	    }
+	}
+
+      template<typename _InputIterator, typename _RandomAccessIterator>
+        static void
+        __select_copy(_InputIterator __first, _InputIterator __last,
+		      _RandomAccessIterator __result_first,
+		      _RandomAccessIterator __result_last)
+        {
+	  typedef typename iterator_traits<_InputIterator>::value_type
+	    _ValueType;
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+	  typedef __simd_iter<_InputIterator> _Iter;
+
+	  const _ValueType* const __end = _Iter::_S_base(__last);
+	  for (const _ValueType* __i = _Iter::_S_base(__first);; ++__i)
+	    {
+	      __i = std::__simd_find_less(__i, __end, *__result_first);
+	      if (__i == __end)
+		break;
+	      std::__adjust_heap(__result_first, _DistanceType(0),
+				 _DistanceType(__result_last
+					       - __result_first),
+				 _ValueType(*__i));
+	    }
+	}
+    };
+
   /**
    *  @if maint
    *  This is a helper function for the sort routines.
@@ -2473,13 +3211,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 		  _RandomAccessIterator __middle,
 		  _RandomAccessIterator __last)
     {
-      typedef typename iterator_traits<_RandomAccessIterator>::value_type
-	_ValueType;
-
       std::make_heap(__first, __middle);
-      for (_RandomAccessIterator __i = __middle; __i < __last; ++__i)
-	if (*__i < *__first)
-	  std::__pop_heap(__first, __middle, __i, _ValueType(*__i));
+      std::__heap_select_simd<__simd_iter<_RandomAccessIterator>::__value>::
+	__select(__first, __middle, __last);
     }
 
   /**
@@ -2517,6 +3251,20 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return __k;
     }
 
+  /**
+   *  @if maint
+   *  partial_sort selects and sorts instead of using a heap once the
+   *  part to sort is more than 1/_S_partial_sort_ratio of the range.
+   *  @endif
+  */
+  enum { _S_partial_sort_ratio = 1024 };
+
+  // Defined with nth_element.
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __partial_sort_select(_RandomAccessIterator, _RandomAccessIterator,
+			  _RandomAccessIterator, _Compare);
+
   /**
    *  @brief Sort the smallest elements of a sequence.
    *  @param  first   An iterator.
@@ -2548,8 +3296,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_valid_range(__first, __middle);
       __glibcxx_requires_valid_range(__middle, __last);
 
-      std::__heap_select(__first, __middle, __last);
-      std::sort_heap(__first, __middle);
+      if (__middle != __last
+	  && (__middle - __first
+	      > (__last - __first) / int(_S_partial_sort_ratio)))
+	std::__partial_sort_select(__first, __middle, __last,
+				   std::__bound_less());
+      else
+	{
+	  std::__heap_select(__first, __middle, __last);
+	  std::sort_heap(__first, __middle);
+	}
     }
 
   /**
@@ -2588,8 +3344,15 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_valid_range(__first, __middle);
       __glibcxx_requires_valid_range(__middle, __last);
 
-      std::__heap_select(__first, __middle, __last, __comp);
-      std::sort_heap(__first, __middle, __comp);
+      if (__middle != __last
+	  && (__middle - __first
+	      > (__last - __first) / int(_S_partial_sort_ratio)))
+	std::__partial_sort_select(__first, __middle, __last, __comp);
+      else
+	{
+	  std::__heap_select(__first, __middle, __last, __comp);
+	  std::sort_heap(__first, __middle, __comp);
+	}
     }
 
   /**
@@ -2619,8 +3382,6 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	_InputValueType;
       typedef typename iterator_traits<_RandomAccessIterator>::value_type
 	_OutputValueType;
-      typedef typename iterator_traits<_RandomAccessIterator>::difference_type
-	_DistanceType;
 
       // concept requirements
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator>)
@@ -2642,15 +3403,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	  ++__first;
 	}
       std::make_heap(__result_first, __result_real_last);
-      while (__first != __last)
-	{
-	  if (*__first < *__result_first)
-	    std::__adjust_heap(__result_first, _DistanceType(0),
-			       _DistanceType(__result_real_last
-					     - __result_first),
-			       _InputValueType(*__first));
-	  ++__first;
-	}
+      const bool __simd = (__simd_iter<_InputIterator>::__value
+			   && __are_same<_InputValueType,
+					 _OutputValueType>::__value);
+      std::__heap_select_simd<__simd>::
+	__select_copy(__first, __last, __result_first, __result_real_last);
       std::sort_heap(__result_first, __result_real_last);
       return __result_real_last;
     }
@@ -2869,6 +3626,238 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	}
     }
 
+  /**
+   *  @if maint
+   *  The searches behind lower_bound and upper_bound.  The general
+   *  form branches on each comparison.  For random access ranges of
+   *  scalars the specialization below halves the range the same way
+   *  whatever the comparison says and only selects which half to
+   *  keep, which the compiler does with a conditional move; the
+   *  loads of the next two candidate midpoints are started early.
+   *  @endif
+  */
+  template<bool>
+    struct __bound_search
+    {
+      template<typename _ForwardIterator, typename _Tp>
+        static _ForwardIterator
+        __lower_bound(_ForwardIterator __first, _ForwardIterator __last,
+		      const _Tp& __val)
+        {
+	  typedef typename iterator_traits<_ForwardIterator>::difference_type
+	    _DistanceType;
+
+	  _DistanceType __len = std::distance(__first, __last);
+	  _DistanceType __half;
+	  _ForwardIterator __middle;
+
+	  while (__len > 0)
+	    {
+	      __half = __len >> 1;
+	      __middle = __first;
+	      std::advance(__middle, __half);
+	      if (*__middle < __val)
+		{
+		  __first = __middle;
+		  ++__first;
+		  __len = __len - __half - 1;
+		}
+	      else
+		__len = __half;
+	    }
+	  return __first;
+	}
+
+      template<typename _ForwardIterator, typename _Tp, typename _Compare>
+        static _ForwardIterator
+        __lower_bound(_ForwardIterator __first, _ForwardIterator __last,
+		      const _Tp& __val, _Compare __comp)
+        {
+	  typedef typename iterator_traits<_ForwardIterator>::difference_type
+	    _DistanceType;
+
+	  _DistanceType __len = std::distance(__first, __last);
+	  _DistanceType __half;
+	  _ForwardIterator __middle;
+
+	  while (__len > 0)
+	    {
+	      __half = __len >> 1;
+	      __middle = __first;
+	      std::advance(__middle, __half);
+	      if (__comp(*__middle, __val))
+		{
+		  __first = __middle;
+		  ++__first;
+		  __len = __len - __half - 1;
+		}
+	      else
+		__len = __half;
+	    }
+	  return __first;
+	}
+
+      template<typename _ForwardIterator, typename _Tp>
+        static _ForwardIterator
+        __upper_bound(_ForwardIterator __first, _ForwardIterator __last,
+		      const _Tp& __val)
+        {
+	  typedef typename iterator_traits<_ForwardIterator>::difference_type
+	    _DistanceType;
+
+	  _DistanceType __len = std::distance(__first, __last);
+	  _DistanceType __half;
+	  _ForwardIterator __middle;
+
+	  while (__len > 0)
+	    {
+	      __half = __len >> 1;
+	      __middle = __first;
+	      std::advance(__middle, __half);
+	      if (__val < *__middle)
+		__len = __half;
+	      else
+		{
+		  __first = __middle;
+		  ++__first;
+		  __len = __len - __half - 1;
+		}
+	    }
+	  return __first;
+	}
+
+      template<typename _ForwardIterator, typename _Tp, typename _Compare>
+        static _ForwardIterator
+        __upper_bound(_ForwardIterator __first, _ForwardIterator __last,
+		      const _Tp& __val, _Compare __comp)
+        {
+	  typedef typename iterator_traits<_ForwardIterator>::difference_type
+	    _DistanceType;
+
+	  _DistanceType __len = std::distance(__first, __last);
+	  _DistanceType __half;
+	  _ForwardIterator __middle;
+
+	  while (__len > 0)
+	    {
+	      __half = __len >> 1;
+	      __middle = __first;
+	      std::advance(__middle, __half);
+	      if (__comp(__val, *__middle))
+		__len = __half;
+	      else
+		{
+		  __first = __middle;
+		  ++__first;
+		  __len = __len - __half - 1;
+		}
+	    }
+	  return __first;
+	}
+    };
+
+  template<>
+    struct __bound_search<true>
+    {
+      template<typename _RandomAccessIterator, typename _Tp>
+        static _RandomAccessIterator
+        __lower_bound(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, const _Tp& __val)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  _DistanceType __len = __last - __first;
+	  if (__len == 0)
+	    return __first;
+	  while (__len > 1)
+	    {
+	      const _DistanceType __half = __len >> 1;
+	      const _DistanceType __next = (__len - __half) >> 1;
+	      std::__iter_prefetch(__first + __next);
+	      std::__iter_prefetch(__first + (__half + __next));
+	      __first = *(__first + __half) < __val ? __first + __half : __first;
+	      __len -= __half;
+	    }
+	  return __first + _DistanceType(bool(*__first < __val));
+	}
+
+      template<typename _RandomAccessIterator, typename _Tp,
+	       typename _Compare>
+        static _RandomAccessIterator
+        __lower_bound(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, const _Tp& __val,
+		      _Compare __comp)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  _DistanceType __len = __last - __first;
+	  if (__len == 0)
+	    return __first;
+	  while (__len > 1)
+	    {
+	      const _DistanceType __half = __len >> 1;
+	      const _DistanceType __next = (__len - __half) >> 1;
+	      std::__iter_prefetch(__first + __next);
+	      std::__iter_prefetch(__first + (__half + __next));
+	      __first = (__comp(*(__first + __half), __val)
+			 ? __first + __half : __first);
+	      __len -= __half;
+	    }
+	  return __first + _DistanceType(bool(__comp(*__first, __val)));
+	}
+
+      template<typename _RandomAccessIterator, typename _Tp>
+        static _RandomAccessIterator
+        __upper_bound(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, const _Tp& __val)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  _DistanceType __len = __last - __first;
+	  if (__len == 0)
+	    return __first;
+	  while (__len > 1)
+	    {
+	      const _DistanceType __half = __len >> 1;
+	      const _DistanceType __next = (__len - __half) >> 1;
+	      std::__iter_prefetch(__first + __next);
+	      std::__iter_prefetch(__first + (__half + __next));
+	      __first = __val < *(__first + __half) ? __first : __first + __half;
+	      __len -= __half;
+	    }
+	  return __first + _DistanceType(!bool(__val < *__first));
+	}
+
+      template<typename _RandomAccessIterator, typename _Tp,
+	       typename _Compare>
+        static _RandomAccessIterator
+        __upper_bound(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, const _Tp& __val,
+		      _Compare __comp)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  _DistanceType __len = __last - __first;
+	  if (__len == 0)
+	    return __first;
+	  while (__len > 1)
+	    {
+	      const _DistanceType __half = __len >> 1;
+	      const _DistanceType __next = (__len - __half) >> 1;
+	      std::__iter_prefetch(__first + __next);
+	      std::__iter_prefetch(__first + (__half + __next));
+	      __first = (__comp(__val, *(__first + __half))
+			 ? __first : __first + __half);
+	      __len -= __half;
+	    }
+	  return __first + _DistanceType(!bool(__comp(__val, *__first)));
+	}
+    };
+
   /**
    *  @brief Finds the first position in which @a val could be inserted
    *         without changing the ordering.
@@ -2886,33 +3875,18 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     {
       typedef typename iterator_traits<_ForwardIterator>::value_type
 	_ValueType;
-      typedef typename iterator_traits<_ForwardIterator>::difference_type
-	_DistanceType;
 
       // concept requirements
       __glibcxx_function_requires(_ForwardIteratorConcept<_ForwardIterator>)
       __glibcxx_function_requires(_LessThanOpConcept<_ValueType, _Tp>)
       __glibcxx_requires_partitioned(__first, __last, __val);
 
-      _DistanceType __len = std::distance(__first, __last);
-      _DistanceType __half;
-      _ForwardIterator __middle;
-
-      while (__len > 0)
-	{
-	  __half = __len >> 1;
-	  __middle = __first;
-	  std::advance(__middle, __half);
-	  if (*__middle < __val)
-	    {
-	      __first = __middle;
-	      ++__first;
-	      __len = __len - __half - 1;
-	    }
-	  else
-	    __len = __half;
-	}
-      return __first;
+      const bool __branchless =
+	(__are_same<typename iterator_traits<_ForwardIterator>::
+		    iterator_category, random_access_iterator_tag>::__value
+	 && __is_scalar<_ValueType>::__value);
+      return std::__bound_search<__branchless>::
+	__lower_bound(__first, __last, __val);
     }
 
   /**
@@ -2936,8 +3910,6 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     {
       typedef typename iterator_traits<_ForwardIterator>::value_type
 	_ValueType;
-      typedef typename iterator_traits<_ForwardIterator>::difference_type
-	_DistanceType;
 
       // concept requirements
       __glibcxx_function_requires(_ForwardIteratorConcept<_ForwardIterator>)
@@ -2945,25 +3917,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 				  _ValueType, _Tp>)
       __glibcxx_requires_partitioned_pred(__first, __last, __val, __comp);
 
-      _DistanceType __len = std::distance(__first, __last);
-      _DistanceType __half;
-      _ForwardIterator __middle;
-
-      while (__len > 0)
-	{
-	  __half = __len >> 1;
-	  __middle = __first;
-	  std::advance(__middle, __half);
-	  if (__comp(*__middle, __val))
-	    {
-	      __first = __middle;
-	      ++__first;
-	      __len = __len - __half - 1;
-	    }
-	  else
-	    __len = __half;
-	}
-      return __first;
+      const bool __branchless =
+	(__are_same<typename iterator_traits<_ForwardIterator>::
+		    iterator_category, random_access_iterator_tag>::__value
+	 && __is_scalar<_ValueType>::__value);
+      return std::__bound_search<__branchless>::
+	__lower_bound(__first, __last, __val, __comp);
     }
 
   /**
@@ -2983,33 +3942,18 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     {
       typedef typename iterator_traits<_ForwardIterator>::value_type
 	_ValueType;
-      typedef typename iterator_traits<_ForwardIterator>::difference_type
-	_DistanceType;
 
       // concept requirements
       __glibcxx_function_requires(_ForwardIteratorConcept<_ForwardIterator>)
       __glibcxx_function_requires(_LessThanOpConcept<_Tp, _ValueType>)
       __glibcxx_requires_partitioned(__first, __last, __val);
 
-      _DistanceType __len = std::distance(__first, __last);
-      _DistanceType __half;
-      _ForwardIterator __middle;
-
-      while (__len > 0)
-	{
-	  __half = __len >> 1;
-	  __middle = __first;
-	  std::advance(__middle, __half);
-	  if (__val < *__middle)
-	    __len = __half;
-	  else
-	    {
-	      __first = __middle;
-	      ++__first;
-	      __len = __len - __half - 1;
-	    }
-	}
-      return __first;
+      const bool __branchless =
+	(__are_same<typename iterator_traits<_ForwardIterator>::
+		    iterator_category, random_access_iterator_tag>::__value
+	 && __is_scalar<_ValueType>::__value);
+      return std::__bound_search<__branchless>::
+	__upper_bound(__first, __last, __val);
     }
 
   /**
@@ -3033,8 +3977,6 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     {
       typedef typename iterator_traits<_ForwardIterator>::value_type
 	_ValueType;
-      typedef typename iterator_traits<_ForwardIterator>::difference_type
-	_DistanceType;
 
       // concept requirements
       __glibcxx_function_requires(_ForwardIteratorConcept<_ForwardIterator>)
@@ -3042,25 +3984,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 				  _Tp, _ValueType>)
       __glibcxx_requires_partitioned_pred(__first, __last, __val, __comp);
 
-      _DistanceType __len = std::distance(__first, __last);
-      _DistanceType __half;
-      _ForwardIterator __middle;
-
-      while (__len > 0)
-	{
-	  __half = __len >> 1;
-	  __middle = __first;
-	  std::advance(__middle, __half);
-	  if (__comp(__val, *__middle))
-	    __len = __half;
-	  else
-	    {
-	      __first = __middle;
-	      ++__first;
-	      __len = __len - __half - 1;
-	    }
-	}
-      return __first;
+      const bool __branchless =
+	(__are_same<typename iterator_traits<_ForwardIterator>::
+		    iterator_category, random_access_iterator_tag>::__value
+	 && __is_scalar<_ValueType>::__value);
+      return std::__bound_search<__branchless>::
+	__upper_bound(__first, __last, __val, __comp);
     }
 
   /**
@@ -3327,135 +4256,6 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 						    __result));
     }
 
-  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
-	   typename _Distance>
-    void
-    __merge_sort_loop(_RandomAccessIterator1 __first,
-		      _RandomAccessIterator1 __last,
-		      _RandomAccessIterator2 __result,
-		      _Distance __step_size)
-    {
-      const _Distance __two_step = 2 * __step_size;
-
-      while (__last - __first >= __two_step)
-	{
-	  __result = std::merge(__first, __first + __step_size,
-				__first + __step_size, __first + __two_step,
-				__result);
-	  __first += __two_step;
-	}
-
-      __step_size = std::min(_Distance(__last - __first), __step_size);
-      std::merge(__first, __first + __step_size, __first + __step_size, __last,
-		 __result);
-    }
-
-  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
-	   typename _Distance, typename _Compare>
-    void
-    __merge_sort_loop(_RandomAccessIterator1 __first,
-		      _RandomAccessIterator1 __last,
-		      _RandomAccessIterator2 __result, _Distance __step_size,
-		      _Compare __comp)
-    {
-      const _Distance __two_step = 2 * __step_size;
-
-      while (__last - __first >= __two_step)
-	{
-	  __result = std::merge(__first, __first + __step_size,
-				__first + __step_size, __first + __two_step,
-				__result,
-				__comp);
-	  __first += __two_step;
-	}
-      __step_size = std::min(_Distance(__last - __first), __step_size);
-
-      std::merge(__first, __first + __step_size,
-		 __first + __step_size, __last,
-		 __result,
-		 __comp);
-    }
-
-  enum { _S_chunk_size = 7 };
-
-  template<typename _RandomAccessIterator, typename _Distance>
-    void
-    __chunk_insertion_sort(_RandomAccessIterator __first,
-			   _RandomAccessIterator __last,
-			   _Distance __chunk_size)
-    {
-      while (__last - __first >= __chunk_size)
-	{
-	  std::__insertion_sort(__first, __first + __chunk_size);
-	  __first += __chunk_size;
-	}
-      std::__insertion_sort(__first, __last);
-    }
-
-  template<typename _RandomAccessIterator, typename _Distance, typename _Compare>
-    void
-    __chunk_insertion_sort(_RandomAccessIterator __first,
-			   _RandomAccessIterator __last,
-			   _Distance __chunk_size, _Compare __comp)
-    {
-      while (__last - __first >= __chunk_size)
-	{
-	  std::__insertion_sort(__first, __first + __chunk_size, __comp);
-	  __first += __chunk_size;
-	}
-      std::__insertion_sort(__first, __last, __comp);
-    }
-
-  template<typename _RandomAccessIterator, typename _Pointer>
-    void
-    __merge_sort_with_buffer(_RandomAccessIterator __first,
-			     _RandomAccessIterator __last,
-                             _Pointer __buffer)
-    {
-      typedef typename iterator_traits<_RandomAccessIterator>::difference_type
-	_Distance;
-
-      const _Distance __len = __last - __first;
-      const _Pointer __buffer_last = __buffer + __len;
-
-      _Distance __step_size = _S_chunk_size;
-      std::__chunk_insertion_sort(__first, __last, __step_size);
-
-      while (__step_size < __len)
-	{
-	  std::__merge_sort_loop(__first, __last, __buffer, __step_size);
-	  __step_size *= 2;
-	  std::__merge_sort_loop(__buffer, __buffer_last, __first, __step_size);
-	  __step_size *= 2;
-	}
-    }
-
-  template<typename _RandomAccessIterator, typename _Pointer, typename _Compare>
-    void
-    __merge_sort_with_buffer(_RandomAccessIterator __first,
-			     _RandomAccessIterator __last,
-                             _Pointer __buffer, _Compare __comp)
-    {
-      typedef typename iterator_traits<_RandomAccessIterator>::difference_type
-	_Distance;
-
-      const _Distance __len = __last - __first;
-      const _Pointer __buffer_last = __buffer + __len;
-
-      _Distance __step_size = _S_chunk_size;
-      std::__chunk_insertion_sort(__first, __last, __step_size, __comp);
-
-      while (__step_size < __len)
-	{
-	  std::__merge_sort_loop(__first, __last, __buffer,
-				 __step_size, __comp);
-	  __step_size *= 2;
-	  std::__merge_sort_loop(__buffer, __buffer_last, __first,
-				 __step_size, __comp);
-	  __step_size *= 2;
-	}
-    }
-
   /**
    *  @if maint
    *  This is a helper function for the merge routines.
@@ -4012,6 +4812,112 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       std::__insertion_sort(__first, __last, __comp);
     }
 
+  /**
+   *  @if maint
+   *  Ranges longer than this are split by Floyd and Rivest's sampling
+   *  rather than by a median of three.
+   *  @endif
+  */
+  enum { _S_select_threshold = 600 };
+
+  /**
+   *  @if maint
+   *  Floyd and Rivest's selection.  To split a long range it first
+   *  selects, recursively, within a window of about n^(2/3) elements
+   *  around nth, sized so that the element it brings to nth is very
+   *  likely to be close to the one sought.  The whole range is then
+   *  partitioned around that element, which leaves only a short range
+   *  to go on with: about 1.5n comparisons in all instead of the 3n or
+   *  so of median-of-three partitioning.  The window is the elements
+   *  already there, not a random sample, so a run of bad splits hands
+   *  over to __introselect.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __floyd_rivest_select(_RandomAccessIterator __first,
+			  _RandomAccessIterator __nth,
+			  _RandomAccessIterator __last, _Compare __comp)
+    {
+      typedef typename iterator_traits<_RandomAccessIterator>::value_type
+	_ValueType;
+      typedef typename iterator_traits<_RandomAccessIterator>::difference_type
+	_DistanceType;
+
+      _DistanceType __depth_limit = std::__lg(__last - __first) * 2;
+      while (__last - __first > int(_S_select_threshold)
+	     && __depth_limit != 0)
+	{
+	  --__depth_limit;
+	  const _DistanceType __n = __last - __first;
+	  const _DistanceType __k = __nth - __first;
+	  const double __z = __builtin_log(double(__n));
+	  const double __s = 0.5 * __builtin_exp(2 * __z / 3);
+	  double __sd = 0.5 * __builtin_sqrt(__z * __s * (__n - __s) / __n);
+	  if (2 * __k < __n)
+	    __sd = -__sd;
+	  _DistanceType __lo = _DistanceType(__k - __k * __s / __n + __sd);
+	  _DistanceType __hi = _DistanceType(__k + (__n - __k) * __s / __n
+					     + __sd) + 1;
+	  __lo = std::max(_DistanceType(0), std::min(__lo, __k));
+	  __hi = std::min(__n, std::max(__hi, __k + 1));
+	  std::__floyd_rivest_select(__first + __lo, __nth, __first + __hi,
+				     __comp);
+
+	  // Partition [first, last) around *nth.  Once the first swap is
+	  // made, the elements at both ends stop the inner scans.
+	  const _ValueType __pivot = *__nth;
+	  _RandomAccessIterator __i = __first;
+	  _RandomAccessIterator __j = __last - 1;
+	  std::iter_swap(__first, __nth);
+	  const bool __pivot_first = __comp(__pivot, *__j);
+	  if (__pivot_first)
+	    std::iter_swap(__first, __j);
+	  while (__i < __j)
+	    {
+	      std::iter_swap(__i, __j);
+	      ++__i;
+	      --__j;
+	      while (__comp(*__i, __pivot))
+		++__i;
+	      while (__comp(__pivot, *__j))
+		--__j;
+	    }
+	  // The pivot is back at one end; move it between the two parts.
+	  if (__pivot_first)
+	    std::iter_swap(__first, __j);
+	  else
+	    std::iter_swap(++__j, __last - 1);
+
+	  if (__j == __nth)
+	    return;
+	  if (__j < __nth)
+	    __first = __j + 1;
+	  else
+	    __last = __j;
+	}
+      std::__introselect(__first, __nth, __last,
+			 std::__lg(__last - __first) * 2, __comp);
+    }
+
+  /**
+   *  @if maint
+   *  partial_sort by selection: when the sorted part is a sizeable
+   *  share of the range, moving the smallest elements to the front in
+   *  one selection and sorting them costs less than the heap, which
+   *  pays a logarithmic sift for every element that enters it.
+   *  @endif
+  */
+  template<typename _RandomAccessIterator, typename _Compare>
+    void
+    __partial_sort_select(_RandomAccessIterator __first,
+			  _RandomAccessIterator __middle,
+			  _RandomAccessIterator __last, _Compare __comp)
+    {
+      std::__floyd_rivest_select(__first, __middle, __last, __comp);
+      std::sort(__first, __middle, __comp);
+    }
+
   /**
    *  @brief Sort a sequence just enough to find a particular position.
    *  @param  first   An iterator.
@@ -4045,8 +4951,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__first == __last || __nth == __last)
 	return;
 
-      std::__introselect(__first, __nth, __last,
-			 std::__lg(__last - __first) * 2);
+      std::__floyd_rivest_select(__first, __nth, __last, std::__bound_less());
     }
 
   /**
@@ -4084,8 +4989,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       if (__first == __last || __nth == __last)
 	return;
 
-      std::__introselect(__first, __nth, __last,
-			 std::__lg(__last - __first) * 2, __comp);
+      std::__floyd_rivest_select(__first, __nth, __last, __comp);
     }
 
   /**
@@ -4278,6 +5182,371 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   // that their input ranges are sorted and the postcondition that their output
   // ranges are sorted.
 
+  /**
+   *  @if maint
+   *  The loops behind includes, set_union, set_intersection and
+   *  set_difference.  The general form merges the two ranges one
+   *  element at a time.  When both ranges are random access and one is
+   *  many times longer than the other, the specialization walks the
+   *  shorter range instead and finds each of its elements in the longer
+   *  one by galloping: probing 1, 2, 4, ... elements ahead and then
+   *  searching the last gap by bisection.  The stretches of the longer
+   *  range between two such elements are skipped, or copied in one go,
+   *  without being compared element by element.  Either way the result
+   *  is exactly that of the merge, equivalent elements included.
+   *  @endif
+  */
+  template<bool>
+    struct __set_merge
+    {
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _Compare>
+        static bool
+        __includes(_InputIterator1 __first1, _InputIterator1 __last1,
+		   _InputIterator2 __first2, _InputIterator2 __last2,
+		   _Compare __comp)
+        {
+	  while (__first1 != __last1 && __first2 != __last2)
+	    if (__comp(*__first2, *__first1))
+	      return false;
+	    else if(__comp(*__first1, *__first2))
+	      ++__first1;
+	    else
+	      ++__first1, ++__first2;
+
+	  return __first2 == __last2;
+	}
+
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __union(_InputIterator1 __first1, _InputIterator1 __last1,
+		_InputIterator2 __first2, _InputIterator2 __last2,
+		_OutputIterator __result, _Compare __comp)
+        {
+	  while (__first1 != __last1 && __first2 != __last2)
+	    {
+	      if (__comp(*__first1, *__first2))
+		{
+		  *__result = *__first1;
+		  ++__first1;
+		}
+	      else if (__comp(*__first2, *__first1))
+		{
+		  *__result = *__first2;
+		  ++__first2;
+		}
+	      else
+		{
+		  *__result = *__first1;
+		  ++__first1;
+		  ++__first2;
+		}
+	      ++__result;
+	    }
+	  return std::copy(__first2, __last2, std::copy(__first1, __last1,
+							__result));
+	}
+
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __intersection(_InputIterator1 __first1, _InputIterator1 __last1,
+		       _InputIterator2 __first2, _InputIterator2 __last2,
+		       _OutputIterator __result, _Compare __comp)
+        {
+	  while (__first1 != __last1 && __first2 != __last2)
+	    if (__comp(*__first1, *__first2))
+	      ++__first1;
+	    else if (__comp(*__first2, *__first1))
+	      ++__first2;
+	    else
+	      {
+		*__result = *__first1;
+		++__first1;
+		++__first2;
+		++__result;
+	      }
+	  return __result;
+	}
+
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __difference(_InputIterator1 __first1, _InputIterator1 __last1,
+		     _InputIterator2 __first2, _InputIterator2 __last2,
+		     _OutputIterator __result, _Compare __comp)
+        {
+	  while (__first1 != __last1 && __first2 != __last2)
+	    if (__comp(*__first1, *__first2))
+	      {
+		*__result = *__first1;
+		++__first1;
+		++__result;
+	      }
+	    else if (__comp(*__first2, *__first1))
+	      ++__first2;
+	    else
+	      {
+		++__first1;
+		++__first2;
+	      }
+	  return std::copy(__first1, __last1, __result);
+	}
+    };
+
+  template<>
+    struct __set_merge<true>
+    {
+      // How many times longer one range must be than the other for
+      // galloping to pay.
+      enum { _S_ratio = 16 };
+
+      template<typename _Distance>
+        static bool
+        _S_skewed(_Distance __len1, _Distance __len2)
+        { return __len1 / _S_ratio > __len2 || __len2 / _S_ratio > __len1; }
+
+      // The first element of [first, last) that is not less than val,
+      // found by galloping from first.
+      template<typename _RandomAccessIterator, typename _Tp,
+	       typename _Compare>
+        static _RandomAccessIterator
+        _S_gallop(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		  const _Tp& __val, _Compare __comp)
+        {
+	  typedef typename iterator_traits<_RandomAccessIterator>::
+	    difference_type _DistanceType;
+
+	  _DistanceType __len = __last - __first;
+	  _DistanceType __step = 1;
+	  while (__step < __len && __comp(*(__first + (__step - 1)), __val))
+	    {
+	      __first += __step;
+	      __len -= __step;
+	      __step <<= 1;
+	    }
+	  return std::__bound_search<false>::
+	    __lower_bound(__first, __first + std::min(__step, __len),
+			  __val, __comp);
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2, typename _Compare>
+        static bool
+        __includes(_RandomAccessIterator1 __first1,
+		   _RandomAccessIterator1 __last1,
+		   _RandomAccessIterator2 __first2,
+		   _RandomAccessIterator2 __last2, _Compare __comp)
+        {
+	  // Each element of the second range uses up one of the first.
+	  if (__last2 - __first2 > __last1 - __first1)
+	    return false;
+	  if ((__last1 - __first1) / _S_ratio <= __last2 - __first2)
+	    return std::__set_merge<false>::
+	      __includes(__first1, __last1, __first2, __last2, __comp);
+
+	  for (; __first2 != __last2; ++__first2, ++__first1)
+	    {
+	      __first1 = _S_gallop(__first1, __last1, *__first2, __comp);
+	      if (__first1 == __last1 || __comp(*__first2, *__first1))
+		return false;
+	    }
+	  return true;
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __union(_RandomAccessIterator1 __first1,
+		_RandomAccessIterator1 __last1,
+		_RandomAccessIterator2 __first2,
+		_RandomAccessIterator2 __last2,
+		_OutputIterator __result, _Compare __comp)
+        {
+	  if (!_S_skewed(__last1 - __first1, __last2 - __first2))
+	    return std::__set_merge<false>::
+	      __union(__first1, __last1, __first2, __last2, __result, __comp);
+
+	  if (__last1 - __first1 > __last2 - __first2)
+	    for (; __first2 != __last2; ++__first2, ++__result)
+	      {
+		_RandomAccessIterator1 __pos =
+		  _S_gallop(__first1, __last1, *__first2, __comp);
+		__result = std::copy(__first1, __pos, __result);
+		__first1 = __pos;
+		if (__first1 != __last1 && !__comp(*__first2, *__first1))
+		  {
+		    *__result = *__first1;
+		    ++__first1;
+		  }
+		else
+		  *__result = *__first2;
+	      }
+	  else
+	    for (; __first1 != __last1; ++__first1, ++__result)
+	      {
+		_RandomAccessIterator2 __pos =
+		  _S_gallop(__first2, __last2, *__first1, __comp);
+		__result = std::copy(__first2, __pos, __result);
+		__first2 = __pos;
+		if (__first2 != __last2 && !__comp(*__first1, *__first2))
+		  ++__first2;
+		*__result = *__first1;
+	      }
+	  return std::copy(__first2, __last2, std::copy(__first1, __last1,
+							__result));
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __intersection(_RandomAccessIterator1 __first1,
+		       _RandomAccessIterator1 __last1,
+		       _RandomAccessIterator2 __first2,
+		       _RandomAccessIterator2 __last2,
+		       _OutputIterator __result, _Compare __comp)
+        {
+	  if (!_S_skewed(__last1 - __first1, __last2 - __first2))
+	    return std::__set_merge<false>::
+	      __intersection(__first1, __last1, __first2, __last2,
+			     __result, __comp);
+
+	  if (__last1 - __first1 > __last2 - __first2)
+	    for (; __first2 != __last2; ++__first2)
+	      {
+		__first1 = _S_gallop(__first1, __last1, *__first2, __comp);
+		if (__first1 == __last1)
+		  break;
+		if (!__comp(*__first2, *__first1))
+		  {
+		    *__result = *__first1;
+		    ++__first1;
+		    ++__result;
+		  }
+	      }
+	  else
+	    for (; __first1 != __last1; ++__first1)
+	      {
+		__first2 = _S_gallop(__first2, __last2, *__first1, __comp);
+		if (__first2 == __last2)
+		  break;
+		if (!__comp(*__first1, *__first2))
+		  {
+		    *__result = *__first1;
+		    ++__first2;
+		    ++__result;
+		  }
+	      }
+	  return __result;
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2,
+	       typename _OutputIterator, typename _Compare>
+        static _OutputIterator
+        __difference(_RandomAccessIterator1 __first1,
+		     _RandomAccessIterator1 __last1,
+		     _RandomAccessIterator2 __first2,
+		     _RandomAccessIterator2 __last2,
+		     _OutputIterator __result, _Compare __comp)
+        {
+	  if (!_S_skewed(__last1 - __first1, __last2 - __first2))
+	    return std::__set_merge<false>::
+	      __difference(__first1, __last1, __first2, __last2,
+			   __result, __comp);
+
+	  if (__last1 - __first1 > __last2 - __first2)
+	    for (; __first2 != __last2 && __first1 != __last1; ++__first2)
+	      {
+		_RandomAccessIterator1 __pos =
+		  _S_gallop(__first1, __last1, *__first2, __comp);
+		__result = std::copy(__first1, __pos, __result);
+		__first1 = __pos;
+		if (__first1 != __last1 && !__comp(*__first2, *__first1))
+		  ++__first1;
+	      }
+	  else
+	    for (; __first1 != __last1; ++__first1)
+	      {
+		__first2 = _S_gallop(__first2, __last2, *__first1, __comp);
+		if (__first2 != __last2 && !__comp(*__first1, *__first2))
+		  ++__first2;
+		else
+		  {
+		    *__result = *__first1;
+		    ++__result;
+		  }
+	      }
+	  return std::copy(__first1, __last1, __result);
+	}
+    };
+
+  // Whether both ranges of a set algorithm are random access.
+  template<typename _Iterator1, typename _Iterator2>
+    struct __set_random_access
+    {
+      enum { __value = (__are_same<typename iterator_traits<_Iterator1>::
+			iterator_category, random_access_iterator_tag>::__value
+			&& __are_same<typename iterator_traits<_Iterator2>::
+			iterator_category, random_access_iterator_tag>::__value)
+      };
+    };
+
+  /**
+   *  @if maint
+   *  Chooses the vector kernel for set_intersection of contiguous
+   *  ranges of the same integral type, at least as wide as int, compared
+   *  with operator<.  Very unequal lengths still go to the galloping
+   *  search, which touches fewer elements than any merge.
+   *  @endif
+  */
+  template<bool>
+    struct __set_intersection_simd
+    {
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _OutputIterator>
+        static _OutputIterator
+        __intersection(_InputIterator1 __first1, _InputIterator1 __last1,
+		       _InputIterator2 __first2, _InputIterator2 __last2,
+		       _OutputIterator __result)
+        {
+	  const bool __gallop = __set_random_access<_InputIterator1,
+						    _InputIterator2>::__value;
+	  return std::__set_merge<__gallop>::
+	    __intersection(__first1, __last1, __first2, __last2, __result,
+			   std::__bound_less());
+	}
+    };
+
+  template<>
+    struct __set_intersection_simd<true>
+    {
+      template<typename _Iterator1, typename _Iterator2,
+	       typename _OutputIterator>
+        static _OutputIterator
+        __intersection(_Iterator1 __first1, _Iterator1 __last1,
+		       _Iterator2 __first2, _Iterator2 __last2,
+		       _OutputIterator __result)
+        {
+	  if (std::__set_merge<true>::_S_skewed(__last1 - __first1,
+						__last2 - __first2))
+	    return std::__set_merge<true>::
+	      __intersection(__first1, __last1, __first2, __last2, __result,
+			     std::__bound_less());
+
+	  typedef __simd_iter<_Iterator1> _Iter1;
+	  typedef __simd_iter<_Iterator2> _Iter2;
+	  return std::__simd_set_intersection(_Iter1::_S_base(__first1),
+					      _Iter1::_S_base(__last1),
+					      _Iter2::_S_base(__first2),
+					      _Iter2::_S_base(__last2),
+					      __result);
+	}
+    };
+
   /**
    *  @brief Determines whether all elements of a sequence exists in a range.
    *  @param  first1  Start of search range.
@@ -4312,15 +5581,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted(__first1, __last1);
       __glibcxx_requires_sorted(__first2, __last2);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (*__first2 < *__first1)
-	  return false;
-	else if(*__first1 < *__first2)
-	  ++__first1;
-	else
-	  ++__first1, ++__first2;
-
-      return __first2 == __last2;
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__includes(__first1, __last1, __first2, __last2, std::__bound_less());
     }
 
   /**
@@ -4363,15 +5627,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted_pred(__first1, __last1, __comp);
       __glibcxx_requires_sorted_pred(__first2, __last2, __comp);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (__comp(*__first2, *__first1))
-	  return false;
-	else if(__comp(*__first1, *__first2))
-	  ++__first1;
-	else
-	  ++__first1, ++__first2;
-
-      return __first2 == __last2;
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__includes(__first1, __last1, __first2, __last2, __comp);
     }
 
   /**
@@ -4415,28 +5674,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted(__first1, __last1);
       __glibcxx_requires_sorted(__first2, __last2);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	{
-	  if (*__first1 < *__first2)
-	    {
-	      *__result = *__first1;
-	      ++__first1;
-	    }
-	  else if (*__first2 < *__first1)
-	    {
-	      *__result = *__first2;
-	      ++__first2;
-	    }
-	  else
-	    {
-	      *__result = *__first1;
-	      ++__first1;
-	      ++__first2;
-	    }
-	  ++__result;
-	}
-      return std::copy(__first2, __last2, std::copy(__first1, __last1,
-						    __result));
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__union(__first1, __last1, __first2, __last2, __result,
+		std::__bound_less());
     }
 
   /**
@@ -4483,28 +5725,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted_pred(__first1, __last1, __comp);
       __glibcxx_requires_sorted_pred(__first2, __last2, __comp);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	{
-	  if (__comp(*__first1, *__first2))
-	    {
-	      *__result = *__first1;
-	      ++__first1;
-	    }
-	  else if (__comp(*__first2, *__first1))
-	    {
-	      *__result = *__first2;
-	      ++__first2;
-	    }
-	  else
-	    {
-	      *__result = *__first1;
-	      ++__first1;
-	      ++__first2;
-	    }
-	  ++__result;
-	}
-      return std::copy(__first2, __last2, std::copy(__first1, __last1,
-						    __result));
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__union(__first1, __last1, __first2, __last2, __result, __comp);
     }
 
   /**
@@ -4545,19 +5769,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted(__first1, __last1);
       __glibcxx_requires_sorted(__first2, __last2);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (*__first1 < *__first2)
-	  ++__first1;
-	else if (*__first2 < *__first1)
-	  ++__first2;
-	else
-	  {
-	    *__result = *__first1;
-	    ++__first1;
-	    ++__first2;
-	    ++__result;
-	  }
-      return __result;
+      const bool __simd = (__simd_iter<_InputIterator1>::__value
+			   && __simd_iter<_InputIterator2>::__value
+			   && __are_same<_ValueType1, _ValueType2>::__value
+			   && __simd_traits<_ValueType1>::__integral
+			   && sizeof(_ValueType1) >= sizeof(int));
+      return std::__set_intersection_simd<__simd>::
+	__intersection(__first1, __last1, __first2, __last2, __result);
     }
 
   /**
@@ -4603,19 +5821,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted_pred(__first1, __last1, __comp);
       __glibcxx_requires_sorted_pred(__first2, __last2, __comp);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (__comp(*__first1, *__first2))
-	  ++__first1;
-	else if (__comp(*__first2, *__first1))
-	  ++__first2;
-	else
-	  {
-	    *__result = *__first1;
-	    ++__first1;
-	    ++__first2;
-	    ++__result;
-	  }
-      return __result;
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__intersection(__first1, __last1, __first2, __last2, __result, __comp);
     }
 
   /**
@@ -4658,21 +5867,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted(__first1, __last1);
       __glibcxx_requires_sorted(__first2, __last2);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (*__first1 < *__first2)
-	  {
-	    *__result = *__first1;
-	    ++__first1;
-	    ++__result;
-	  }
-	else if (*__first2 < *__first1)
-	  ++__first2;
-	else
-	  {
-	    ++__first1;
-	    ++__first2;
-	  }
-      return std::copy(__first1, __last1, __result);
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__difference(__first1, __last1, __first2, __last2, __result,
+		     std::__bound_less());
     }
 
   /**
@@ -4720,21 +5919,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_sorted_pred(__first1, __last1, __comp);
       __glibcxx_requires_sorted_pred(__first2, __last2, __comp);
 
-      while (__first1 != __last1 && __first2 != __last2)
-	if (__comp(*__first1, *__first2))
-	  {
-	    *__result = *__first1;
-	    ++__first1;
-	    ++__result;
-	  }
-	else if (__comp(*__first2, *__first1))
-	  ++__first2;
-	else
-	  {
-	    ++__first1;
-	    ++__first2;
-	  }
-      return std::copy(__first1, __last1, __result);
+      const bool __gallop = __set_random_access<_InputIterator1,
+						_InputIterator2>::__value;
+      return std::__set_merge<__gallop>::
+	__difference(__first1, __last1, __first2, __last2, __result, __comp);
     }
 
   /**
@@ -4870,6 +6058,72 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
   // min_element and max_element, with and without an explicitly supplied
   // comparison function.
 
+  /**
+   *  @if maint
+   *  Scalar and vector forms of min_element and max_element without a
+   *  comparison functor.  The vector form is used for contiguous ranges
+   *  of integral type only: for floating point, NaNs make the answer
+   *  depend on the order of the comparisons.
+   *  @endif
+  */
+  template<bool>
+    struct __extremum_simd
+    {
+      template<typename _ForwardIterator>
+        static _ForwardIterator
+        __max_element(_ForwardIterator __first, _ForwardIterator __last)
+        {
+	  if (__first == __last)
+	    return __first;
+	  _ForwardIterator __result = __first;
+	  while (++__first != __last)
+	    if (*__result < *__first)
+	      __result = __first;
+	  return __result;
+	}
+
+      template<typename _ForwardIterator>
+        static _ForwardIterator
+        __min_element(_ForwardIterator __first, _ForwardIterator __last)
+        {
+	  if (__first == __last)
+	    return __first;
+	  _ForwardIterator __result = __first;
+	  while (++__first != __last)
+	    if (*__first < *__result)
+	      __result = __first;
+	  return __result;
+	}
+    };
+
+  template<>
+    struct __extremum_simd<true>
+    {
+      template<typename _Iterator>
+        static _Iterator
+        __max_element(_Iterator __first, _Iterator __last)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  typedef typename iterator_traits<_Iterator>::value_type _ValueType;
+	  return __first
+	    + (std::__simd_extremum_element<__simd_max<_ValueType> >
+	       (_Iter::_S_base(__first), _Iter::_S_base(__last))
+	       - _Iter::_S_base(__first));
+	}
+
+      template<typename _Iterator>
+        static _Iterator
+        __min_element(_Iterator __first, _Iterator __last)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  typedef typename iterator_traits<_Iterator>::value_type _ValueType;
+	  return __first
+	    + (std::__simd_extremum_element<__simd_min<_ValueType> >
+	       (_Iter::_S_base(__first), _Iter::_S_base(__last))
+	       - _Iter::_S_base(__first));
+	}
+    };
+
   /**
    *  @brief  Return the maximum element in a range.
    *  @param  first  Start of range.
@@ -4886,13 +6140,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_ForwardIterator>::value_type>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      if (__first == __last)
-	return __first;
-      _ForwardIterator __result = __first;
-      while (++__first != __last)
-	if (*__result < *__first)
-	  __result = __first;
-      return __result;
+      typedef typename iterator_traits<_ForwardIterator>::value_type
+	_ValueType;
+      const bool __simd = (__simd_iter<_ForwardIterator>::__value
+			   && __simd_traits<_ValueType>::__integral);
+      return std::__extremum_simd<__simd>::__max_element(__first, __last);
     }
 
   /**
@@ -4938,13 +6190,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_ForwardIterator>::value_type>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      if (__first == __last)
-	return __first;
-      _ForwardIterator __result = __first;
-      while (++__first != __last)
-	if (*__first < *__result)
-	  __result = __first;
-      return __result;
+      typedef typename iterator_traits<_ForwardIterator>::value_type
+	_ValueType;
+      const bool __simd = (__simd_iter<_ForwardIterator>::__value
+			   && __simd_traits<_ValueType>::__integral);
+      return std::__extremum_simd<__simd>::__min_element(__first, __last);
     }
 
   /**
@@ -75,6 +75,7 @@
 #include <bits/stl_iterator_base_funcs.h>
 #include <bits/stl_iterator.h>
 #include <bits/concept_check.h>
+#include <bits/stl_simd.h>
 #include <debug/debug.h>
 
 _GLIBCXX_BEGIN_NAMESPACE(std)
@@ -100,6 +101,28 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __b = __tmp;
     }
 
+  /**
+   *  @if maint
+   *  Hints that the element at __i will be read soon.  Only iterators
+   *  known to point into an array are followed; for the others this
+   *  does nothing.  __i need not be dereferenceable.
+   *  @endif
+  */
+  template<typename _Iterator>
+    inline void
+    __iter_prefetch(const _Iterator&)
+    { }
+
+  template<typename _Tp>
+    inline void
+    __iter_prefetch(_Tp* __p)
+    { __builtin_prefetch(__p); }
+
+  template<typename _Tp, typename _Container>
+    inline void
+    __iter_prefetch(const __gnu_cxx::__normal_iterator<_Tp*, _Container>& __i)
+    { __builtin_prefetch(__i.base()); }
+
   // See http://gcc.gnu.org/ml/libstdc++/2004-08/msg00167.html: in a
   // nutshell, we are partially implementing the resolution of DR 187,
   // when it's safe, i.e., the value_types are equal.
@@ -689,6 +712,61 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return __first + __n;
     }
 
+  /**
+   *  @if maint
+   *  Chooses between the generic mismatch() loop and the vector kernel,
+   *  which handles two contiguous ranges of the same arithmetic type.
+   *  @endif
+  */
+  template<bool>
+    struct __mismatch_simd
+    {
+      template<typename _InputIterator1, typename _InputIterator2>
+        static pair<_InputIterator1, _InputIterator2>
+        __mismatch(_InputIterator1 __first1, _InputIterator1 __last1,
+		   _InputIterator2 __first2)
+        {
+	  while (__first1 != __last1 && *__first1 == *__first2)
+	    {
+	      ++__first1;
+	      ++__first2;
+	    }
+	  return pair<_InputIterator1, _InputIterator2>(__first1, __first2);
+	}
+    };
+
+  template<>
+    struct __mismatch_simd<true>
+    {
+      template<typename _Iterator1, typename _Iterator2>
+        static pair<_Iterator1, _Iterator2>
+        __mismatch(_Iterator1 __first1, _Iterator1 __last1,
+		   _Iterator2 __first2)
+        {
+	  typedef __simd_iter<_Iterator1> _Iter1;
+	  typedef __simd_iter<_Iterator2> _Iter2;
+	  const ptrdiff_t __n =
+	    std::__simd_mismatch(_Iter1::_S_base(__first1),
+				 _Iter1::_S_base(__last1),
+				 _Iter2::_S_base(__first2))
+	    - _Iter1::_S_base(__first1);
+	  return pair<_Iterator1, _Iterator2>(__first1 + __n, __first2 + __n);
+	}
+    };
+
+  template<typename _InputIterator1, typename _InputIterator2>
+    struct __simd_iter_pair
+    {
+      typedef typename iterator_traits<_InputIterator1>::value_type
+	_ValueType1;
+      typedef typename iterator_traits<_InputIterator2>::value_type
+	_ValueType2;
+
+      enum { __value = (__simd_iter<_InputIterator1>::__value
+			&& __simd_iter<_InputIterator2>::__value
+			&& __are_same<_ValueType1, _ValueType2>::__value) };
+    };
+
   /**
    *  @brief Finds the places in ranges which don't match.
    *  @param  first1  An input iterator.
@@ -714,12 +792,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_InputIterator2>::value_type>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
-      while (__first1 != __last1 && *__first1 == *__first2)
-        {
-	  ++__first1;
-	  ++__first2;
-        }
-      return pair<_InputIterator1, _InputIterator2>(__first1, __first2);
+      const bool __simd = __simd_iter_pair<_InputIterator1,
+					   _InputIterator2>::__value;
+      return std::__mismatch_simd<__simd>::__mismatch(__first1, __last1,
+						      __first2);
     }
 
   /**
@@ -778,6 +854,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	    typename iterator_traits<_InputIterator1>::value_type,
 	    typename iterator_traits<_InputIterator2>::value_type>)
       __glibcxx_requires_valid_range(__first1, __last1);
+
+      const bool __simd = __simd_iter_pair<_InputIterator1,
+					   _InputIterator2>::__value;
+      if (__simd)
+	return (std::__mismatch_simd<__simd>::__mismatch(__first1, __last1,
+							 __first2).first
+		== __last1);
       
       for (; __first1 != __last1; ++__first1, ++__first2)
 	if (!(*__first1 == *__first2))
@@ -816,6 +899,56 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       return true;
     }
 
+  template<bool>
+    struct __lexicographical_compare_simd
+    {
+      template<typename _InputIterator1, typename _InputIterator2>
+        static bool
+        __lc(_InputIterator1 __first1, _InputIterator1 __last1,
+	     _InputIterator2 __first2, _InputIterator2 __last2)
+        {
+	  for (; __first1 != __last1 && __first2 != __last2;
+	       ++__first1, ++__first2)
+	    {
+	      if (*__first1 < *__first2)
+		return true;
+	      if (*__first2 < *__first1)
+		return false;
+	    }
+	  return __first1 == __last1 && __first2 != __last2;
+	}
+    };
+
+  // For integers, neither of two elements is less than the other
+  // exactly when they are equal, so the first mismatch decides.
+  // Floating-point ranges are left to the generic loop, which must
+  // step over unordered (NaN) pairs.
+  template<>
+    struct __lexicographical_compare_simd<true>
+    {
+      template<typename _Iterator1, typename _Iterator2>
+        static bool
+        __lc(_Iterator1 __first1, _Iterator1 __last1,
+	     _Iterator2 __first2, _Iterator2 __last2)
+        {
+	  typedef typename iterator_traits<_Iterator1>::value_type _ValueType;
+	  if (!__simd_traits<_ValueType>::__integral)
+	    return __lexicographical_compare_simd<false>::__lc(__first1,
+							       __last1,
+							       __first2,
+							       __last2);
+	  const ptrdiff_t __len1 = __last1 - __first1;
+	  const ptrdiff_t __len2 = __last2 - __first2;
+	  const ptrdiff_t __len = std::min(__len1, __len2);
+	  pair<_Iterator1, _Iterator2> __m =
+	    __mismatch_simd<true>::__mismatch(__first1, __first1 + __len,
+					      __first2);
+	  if (__m.first != __first1 + __len)
+	    return *__m.first < *__m.second;
+	  return __len1 < __len2;
+	}
+    };
+
   /**
    *  @brief Performs "dictionary" comparison on ranges.
    *  @param  first1  An input iterator.
@@ -847,15 +980,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_requires_valid_range(__first1, __last1);
       __glibcxx_requires_valid_range(__first2, __last2);
 
-      for (; __first1 != __last1 && __first2 != __last2;
-	   ++__first1, ++__first2)
-	{
-	  if (*__first1 < *__first2)
-	    return true;
-	  if (*__first2 < *__first1)
-	    return false;
-	}
-      return __first1 == __last1 && __first2 != __last2;
+      return std::__lexicographical_compare_simd<
+	__simd_iter_pair<_InputIterator1, _InputIterator2>::__value>::
+	__lc(__first1, __last1, __first2, __last2);
     }
 
   /**
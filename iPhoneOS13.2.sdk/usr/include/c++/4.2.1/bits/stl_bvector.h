@@ -353,26 +353,259 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
   operator+(ptrdiff_t __n, const _Bit_const_iterator& __x)
   { return __x + __n; }
 
-  inline void
-  __fill_bvector(_Bit_iterator __first, _Bit_iterator __last, bool __x)
+  // The low __n bits of a word, for 0 < __n <= _S_word_bit.
+  inline _Bit_type
+  __bit_low_mask(unsigned int __n)
   {
-    for (; __first != __last; ++__first)
-      *__first = __x;
+    return (__n < unsigned(_S_word_bit) ? (_Bit_type(1) << __n) - 1
+	    : ~_Bit_type(0));
   }
 
-  inline void
-  fill(_Bit_iterator __first, _Bit_iterator __last, const bool& __x)
+  // The _S_word_bit bits that start at bit __off of the word at __p.
+  inline _Bit_type
+  __bit_word(const _Bit_type* __p, unsigned int __off)
+  {
+    return (__off ? (__p[0] >> __off) | (__p[1] << (int(_S_word_bit) - __off))
+	    : __p[0]);
+  }
+
+  // The __n bits, 0 < __n <= _S_word_bit, that start at bit __off of
+  // the word at __p, in the low bits.  The next word is read only if
+  // some of them are in it.
+  inline _Bit_type
+  __bit_word(const _Bit_type* __p, unsigned int __off, unsigned int __n)
+  {
+    _Bit_type __w = __p[0] >> __off;
+    if (__off + __n > unsigned(_S_word_bit))
+      __w |= __p[1] << (int(_S_word_bit) - __off);
+    return __w & __bit_low_mask(__n);
+  }
+
+  /**
+   *  @if maint
+   *  The word-at-a-time loops behind the find, count, fill, copy and
+   *  equal overloads for vector<bool> iterators.  A word that is only
+   *  partly in a range is masked, or assembled by shifts from the two
+   *  words it straddles; the word holding the end of a range is never
+   *  read when the range ends at its first bit, since it may lie past
+   *  the storage.
+   *  @endif
+   */
+  // The distance from __first to the first bit of [first, last) equal
+  // to __x, or last - first.
+  inline ptrdiff_t
+  __find_bvector(const _Bit_iterator_base& __first,
+		 const _Bit_iterator_base& __last, bool __x)
+  {
+    if (__first == __last)
+      return 0;
+
+    const _Bit_type __flip = __x ? _Bit_type(0) : ~_Bit_type(0);
+    const _Bit_type* __p = __first._M_p;
+    _Bit_type __w = (*__p ^ __flip) & (~_Bit_type(0) << __first._M_offset);
+    while (__p != __last._M_p)
+      {
+	if (__w)
+	  break;
+	if (++__p == __last._M_p)
+	  __w = (__last._M_offset ? *__p ^ __flip : _Bit_type(0));
+	else
+	  __w = *__p ^ __flip;
+      }
+    if (__p == __last._M_p && __last._M_offset)
+      __w &= __bit_low_mask(__last._M_offset);
+    if (!__w)
+      return __last - __first;
+    return (int(_S_word_bit) * (__p - __first._M_p)
+	    + __builtin_ctzl(__w) - __first._M_offset);
+  }
+
+  // The number of set bits in [first, last).
+  inline ptrdiff_t
+  __count_bvector(const _Bit_iterator_base& __first,
+		  const _Bit_iterator_base& __last)
+  {
+    if (__first == __last)
+      return 0;
+
+    const _Bit_type* __p = __first._M_p;
+    if (__p == __last._M_p)
+      return __builtin_popcountl(__bit_word(__p, __first._M_offset,
+						 __last - __first));
+
+    ptrdiff_t __n = __builtin_popcountl(*__p >> __first._M_offset);
+    for (++__p; __p != __last._M_p; ++__p)
+      __n += __builtin_popcountl(*__p);
+    if (__last._M_offset)
+      __n += __builtin_popcountl(*__p
+				 & __bit_low_mask(__last._M_offset));
+    return __n;
+  }
+
+  // Copies [first, last) to result, a word of the destination at a
+  // time.  As for copy, result may be before first in an overlapping
+  // range: the source words a store could reach have been read.
+  inline _Bit_iterator
+  __copy_bvector(const _Bit_iterator_base& __first,
+		 const _Bit_iterator_base& __last, _Bit_iterator __result)
   {
-    if (__first._M_p != __last._M_p)
+    const ptrdiff_t __len = __last - __first;
+    const _Bit_type* __p = __first._M_p;
+    unsigned int __off = __first._M_offset;
+    _Bit_type* __q = __result._M_p;
+    ptrdiff_t __n = __len;
+
+    if (__result._M_offset && __n > 0)
       {
-	std::fill(__first._M_p + 1, __last._M_p, __x ? ~0 : 0);
-	__fill_bvector(__first, _Bit_iterator(__first._M_p + 1, 0), __x);
-	__fill_bvector(_Bit_iterator(__last._M_p, 0), __last, __x);
+	// Fill the rest of the first destination word.
+	const unsigned int __d = __result._M_offset;
+	const unsigned int __k =
+	  std::min(__n, ptrdiff_t(int(_S_word_bit) - __d));
+	const _Bit_type __mask = __bit_low_mask(__k) << __d;
+	*__q = (*__q & ~__mask) | (__bit_word(__p, __off, __k) << __d);
+	__off += __k;
+	__p += __off / int(_S_word_bit);
+	__off %= int(_S_word_bit);
+	__n -= __k;
+	++__q;
       }
+    for (; __n >= int(_S_word_bit); __n -= int(_S_word_bit), ++__p, ++__q)
+      *__q = __bit_word(__p, __off);
+    if (__n > 0)
+      {
+	const _Bit_type __mask = __bit_low_mask(__n);
+	*__q = (*__q & ~__mask) | __bit_word(__p, __off, __n);
+      }
+    return __result + __len;
+  }
+
+  // Whether [first1, last1) and the range at first2 hold the same bits.
+  inline bool
+  __equal_bvector(const _Bit_iterator_base& __first1,
+		  const _Bit_iterator_base& __last1,
+		  const _Bit_iterator_base& __first2)
+  {
+    const _Bit_type* __p1 = __first1._M_p;
+    const _Bit_type* __p2 = __first2._M_p;
+    const unsigned int __off1 = __first1._M_offset;
+    const unsigned int __off2 = __first2._M_offset;
+    ptrdiff_t __n = __last1 - __first1;
+
+    for (; __n >= int(_S_word_bit); __n -= int(_S_word_bit), ++__p1, ++__p2)
+      if (__bit_word(__p1, __off1) != __bit_word(__p2, __off2))
+	return false;
+    return (__n <= 0
+	    || (__bit_word(__p1, __off1, __n)
+		== __bit_word(__p2, __off2, __n)));
+  }
+
+  // Fills [first, last), which lies within one word or ends at the
+  // start of the next.
+  inline void
+  __fill_bvector(_Bit_iterator __first, _Bit_iterator __last, bool __x)
+  {
+    if (__first == __last)
+      return;
+    _Bit_type __mask = ~_Bit_type(0) << __first._M_offset;
+    if (__last._M_p == __first._M_p)
+      __mask &= __bit_low_mask(__last._M_offset);
+    if (__x)
+      *__first._M_p |= __mask;
     else
-      __fill_bvector(__first, __last, __x);
+      *__first._M_p &= ~__mask;
   }
 
+  // A template, like find and count below, so that it is also chosen
+  // over the generic fill for a value that is not a bool.
+  template<typename _Tp>
+    inline void
+    fill(_Bit_iterator __first, _Bit_iterator __last, const _Tp& __val)
+    {
+      const bool __x = bool(__val);
+      if (__first._M_p != __last._M_p)
+	{
+	  std::fill(__first._M_p + 1, __last._M_p, __x ? ~0 : 0);
+	  __fill_bvector(__first, _Bit_iterator(__first._M_p + 1, 0), __x);
+	  __fill_bvector(_Bit_iterator(__last._M_p, 0), __last, __x);
+	}
+      else
+	__fill_bvector(__first, __last, __x);
+    }
+
+  // find and count compare each bit with __val, as the generic
+  // algorithms do, so a value equal to neither true nor false matches
+  // no bit, and one equal to both matches every bit.
+  template<typename _Tp>
+    inline _Bit_iterator
+    find(_Bit_iterator __first, _Bit_iterator __last, const _Tp& __val)
+    {
+      if (__first == __last || (__val == true && __val == false))
+	return __first;
+      if (__val == true)
+	return __first + __find_bvector(__first, __last, true);
+      if (__val == false)
+	return __first + __find_bvector(__first, __last, false);
+      return __last;
+    }
+
+  template<typename _Tp>
+    inline _Bit_const_iterator
+    find(_Bit_const_iterator __first, _Bit_const_iterator __last,
+	 const _Tp& __val)
+    {
+      if (__first == __last || (__val == true && __val == false))
+	return __first;
+      if (__val == true)
+	return __first + __find_bvector(__first, __last, true);
+      if (__val == false)
+	return __first + __find_bvector(__first, __last, false);
+      return __last;
+    }
+
+  template<typename _Tp>
+    inline ptrdiff_t
+    count(_Bit_iterator __first, _Bit_iterator __last, const _Tp& __val)
+    {
+      const bool __t = __val == true;
+      const bool __f = __val == false;
+      if (!__t && !__f)
+	return 0;
+      const ptrdiff_t __n = __count_bvector(__first, __last);
+      return (__t ? __n : 0) + (__f ? (__last - __first) - __n : 0);
+    }
+
+  template<typename _Tp>
+    inline ptrdiff_t
+    count(_Bit_const_iterator __first, _Bit_const_iterator __last,
+	  const _Tp& __val)
+    {
+      const bool __t = __val == true;
+      const bool __f = __val == false;
+      if (!__t && !__f)
+	return 0;
+      const ptrdiff_t __n = __count_bvector(__first, __last);
+      return (__t ? __n : 0) + (__f ? (__last - __first) - __n : 0);
+    }
+
+  inline _Bit_iterator
+  copy(_Bit_iterator __first, _Bit_iterator __last, _Bit_iterator __result)
+  { return __copy_bvector(__first, __last, __result); }
+
+  inline _Bit_iterator
+  copy(_Bit_const_iterator __first, _Bit_const_iterator __last,
+       _Bit_iterator __result)
+  { return __copy_bvector(__first, __last, __result); }
+
+  inline bool
+  equal(_Bit_iterator __first1, _Bit_iterator __last1,
+	_Bit_iterator __first2)
+  { return __equal_bvector(__first1, __last1, __first2); }
+
+  inline bool
+  equal(_Bit_const_iterator __first1, _Bit_const_iterator __last1,
+	_Bit_const_iterator __first2)
+  { return __equal_bvector(__first1, __last1, __first2); }
+
   template<class _Alloc>
     struct _Bvector_base
     {
@@ -766,6 +999,32 @@ template<typename _Alloc>
     clear()
     { _M_erase_at_end(begin()); }
 
+    /**
+     *  @brief  Finds the index of the first true element.
+     *  @return  The index of the first true element, or size() if none.
+     *  @ingroup SGIextensions
+     *  @sa  _Find_next
+     */
+    size_type
+    _Find_first() const
+    { return __find_bvector(begin(), end(), true); }
+
+    /**
+     *  @brief  Finds the index of the next true element after prev.
+     *  @return  The index of the next true element, or size() if none.
+     *  @param  prev  Where to start searching.
+     *  @ingroup SGIextensions
+     *  @sa  _Find_first
+     */
+    size_type
+    _Find_next(size_type __prev) const
+    {
+      if (__prev + 1 >= size())
+	return size();
+      const const_iterator __first = begin() + difference_type(__prev + 1);
+      return __prev + 1 + __find_bvector(__first, end(), true);
+    }
+
    
   protected:
     // Precondition: __first._M_offset == 0 && __result._M_offset == 0.
@@ -1006,6 +1265,15 @@ template<typename _Alloc>
     { this->_M_impl._M_finish = __pos; }
   };
 
+  // The generic operator== reaches std::equal through a name looked up
+  // before the overload above for vector<bool> iterators was declared.
+  template<typename _Alloc>
+    inline bool
+    operator==(const vector<bool, _Alloc>& __x,
+	       const vector<bool, _Alloc>& __y)
+    { return (__x.size() == __y.size()
+	      && __equal_bvector(__x.begin(), __x.end(), __y.begin())); }
+
 _GLIBCXX_END_NESTED_NAMESPACE
 
 #endif
@@ -101,6 +101,36 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
       _Tp _M_data;                ///< User's data.
     };
 
+  /// @if maint Orders two nodes by their values using operator<.  @endif
+  template<typename _Tp>
+    struct _List_node_less
+    {
+      bool
+      operator()(_List_node_base* __x, _List_node_base* __y) const
+      {
+	return (static_cast<_List_node<_Tp>*>(__x)->_M_data
+		< static_cast<_List_node<_Tp>*>(__y)->_M_data);
+      }
+    };
+
+  /// @if maint Orders two nodes by their values using a comparator.  @endif
+  template<typename _Tp, typename _Compare>
+    struct _List_node_compare
+    {
+      _Compare _M_comp;
+
+      explicit
+      _List_node_compare(_Compare __comp)
+      : _M_comp(__comp) { }
+
+      bool
+      operator()(_List_node_base* __x, _List_node_base* __y)
+      {
+	return _M_comp(static_cast<_List_node<_Tp>*>(__x)->_M_data,
+		       static_cast<_List_node<_Tp>*>(__y)->_M_data);
+      }
+    };
+
   /**
    *  @brief A list::iterator.
    *
@@ -1080,6 +1110,13 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
        *
        *  Sorts the elements of this list in NlogN time.  Equivalent
        *  elements remain in list order.
+       *
+       *  @if maint
+       *  Long lists are sorted as an array of node pointers obtained
+       *  from nothrow operator new, so that the merge passes walk
+       *  contiguous memory instead of chasing scattered links; if the
+       *  array cannot be had, the nodes are merged by splicing.
+       *  @endif
        */
       void
       sort();
@@ -1149,6 +1186,13 @@ _GLIBCXX_BEGIN_NESTED_NAMESPACE(std, _GLIBCXX_STD)
       _M_fill_assign(size_type __n, const value_type& __val);
 
 
+      // Sorts the list through a temporary array of node pointers,
+      // ordered by __comp, and relinks the nodes in one pass.  Returns
+      // false, leaving the list untouched, if no array could be had.
+      template<typename _NodeCompare>
+        bool
+        _M_sort_nodes(_NodeCompare __comp);
+
       // Moves the elements from [first,last) before position.
       void
       _M_transfer(iterator __position, iterator __first, iterator __last)
@@ -62,9 +62,70 @@
 #define _STL_NUMERIC_H 1
 
 #include <debug/debug.h>
+#include <bits/stl_simd.h>
 
 _GLIBCXX_BEGIN_NAMESPACE(std)
 
+  /**
+   *  @if maint
+   *  Sequential and vector forms of accumulate and inner_product with
+   *  the default operators.  The vector form reorders the additions, so
+   *  the standard algorithms only use it for integral types at least as
+   *  wide as int, whose sums wrap the same way in any order.  (Narrower
+   *  ones are promoted to int element by element.)  The fast_ variants
+   *  in ext/numeric also allow it for floating point.
+   *  @endif
+  */
+  template<bool>
+    struct __accumulate_simd
+    {
+      template<typename _InputIterator, typename _Tp>
+        static _Tp
+        __accumulate(_InputIterator __first, _InputIterator __last,
+		     _Tp __init)
+        {
+	  for (; __first != __last; ++__first)
+	    __init = __init + *__first;
+	  return __init;
+	}
+
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _Tp>
+        static _Tp
+        __inner_product(_InputIterator1 __first1, _InputIterator1 __last1,
+			_InputIterator2 __first2, _Tp __init)
+        {
+	  for (; __first1 != __last1; ++__first1, ++__first2)
+	    __init = __init + (*__first1 * *__first2);
+	  return __init;
+	}
+    };
+
+  template<>
+    struct __accumulate_simd<true>
+    {
+      template<typename _Iterator, typename _Tp>
+        static _Tp
+        __accumulate(_Iterator __first, _Iterator __last, _Tp __init)
+        {
+	  typedef __simd_iter<_Iterator> _Iter;
+	  return std::__simd_sum(_Iter::_S_base(__first),
+				 _Iter::_S_base(__last), __init);
+	}
+
+      template<typename _Iterator1, typename _Iterator2, typename _Tp>
+        static _Tp
+        __inner_product(_Iterator1 __first1, _Iterator1 __last1,
+			_Iterator2 __first2, _Tp __init)
+        {
+	  typedef __simd_iter<_Iterator1> _Iter1;
+	  typedef __simd_iter<_Iterator2> _Iter2;
+	  return std::__simd_dot(_Iter1::_S_base(__first1),
+				 _Iter1::_S_base(__last1),
+				 _Iter2::_S_base(__first2), __init);
+	}
+    };
+
   /**
    *  @brief  Accumulate values in a range.
    *
@@ -84,9 +145,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator>)
       __glibcxx_requires_valid_range(__first, __last);
 
-      for (; __first != __last; ++__first)
-	__init = __init + *__first;
-      return __init;
+      typedef typename iterator_traits<_InputIterator>::value_type _ValueType;
+      const bool __simd = (__simd_iter<_InputIterator>::__value
+			   && __are_same<_ValueType, _Tp>::__value
+			   && __simd_traits<_Tp>::__integral
+			   && sizeof(_Tp) >= sizeof(int));
+      return std::__accumulate_simd<__simd>::__accumulate(__first, __last,
+							 __init);
     }
 
   /**
@@ -140,9 +205,18 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator2>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
-      for (; __first1 != __last1; ++__first1, ++__first2)
-	__init = __init + (*__first1 * *__first2);
-      return __init;
+      typedef typename iterator_traits<_InputIterator1>::value_type
+	_ValueType1;
+      typedef typename iterator_traits<_InputIterator2>::value_type
+	_ValueType2;
+      const bool __simd = (__simd_iter<_InputIterator1>::__value
+			   && __simd_iter<_InputIterator2>::__value
+			   && __are_same<_ValueType1, _Tp>::__value
+			   && __are_same<_ValueType2, _Tp>::__value
+			   && __simd_traits<_Tp>::__integral
+			   && sizeof(_Tp) >= sizeof(int));
+      return std::__accumulate_simd<__simd>::__inner_product(__first1, __last1,
+							    __first2, __init);
     }
 
   /**
@@ -0,0 +1,1139 @@
+// SIMD kernels for the algorithms -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file stl_simd.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _STL_SIMD_H
+#define _STL_SIMD_H 1
+
+#include <bits/c++config.h>
+#include <cstddef>
+#include <bits/cpp_type_traits.h>
+
+// The kernels below are written against the compiler's generic vector
+// extension, so the same source becomes NEON, SSE2 or AVX2 code
+// depending on the target.  The instruction set is fixed when the
+// program is compiled; define _GLIBCXX_NO_SIMD to use the scalar
+// loops everywhere.
+#ifndef _GLIBCXX_USE_SIMD
+# if !defined(_GLIBCXX_NO_SIMD) \
+  && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__SSE2__)) \
+  && (defined(__clang__) \
+      || (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+#  define _GLIBCXX_USE_SIMD 1
+# else
+#  define _GLIBCXX_USE_SIMD 0
+# endif
+#endif
+
+// Width in bytes of one vector register.
+#ifndef _GLIBCXX_SIMD_WIDTH
+# ifdef __AVX2__
+#  define _GLIBCXX_SIMD_WIDTH 32
+# else
+#  define _GLIBCXX_SIMD_WIDTH 16
+# endif
+#endif
+
+_GLIBCXX_BEGIN_NAMESPACE(std)
+
+  /**
+   *  @if maint
+   *  Describes how a scalar type maps onto a vector register.  __vec
+   *  holds __lanes values of _Tp, and __mask is the signed integer
+   *  vector of the same shape that a lane-wise comparison yields.
+   *  Only types for which __value is true have the typedefs.
+   *  @endif
+   */
+  template<typename _Tp>
+    struct __simd_traits
+    {
+      enum { __value = 0 };
+      enum { __integral = 0 };
+    };
+
+#if _GLIBCXX_USE_SIMD
+#define _GLIBCXX_SIMD_TRAITS(_Tp, _Mp, _Integral)			\
+  template<>								\
+    struct __simd_traits<_Tp>						\
+    {									\
+      enum { __value = 1 };						\
+      enum { __integral = _Integral };					\
+      enum { __lanes = _GLIBCXX_SIMD_WIDTH / sizeof(_Tp) };		\
+      typedef _Tp __vec							\
+        __attribute__((__vector_size__(_GLIBCXX_SIMD_WIDTH)));		\
+      typedef _Mp __mask						\
+        __attribute__((__vector_size__(_GLIBCXX_SIMD_WIDTH)));		\
+    };
+
+  _GLIBCXX_SIMD_TRAITS(char, signed char, 1)
+  _GLIBCXX_SIMD_TRAITS(signed char, signed char, 1)
+  _GLIBCXX_SIMD_TRAITS(unsigned char, signed char, 1)
+  _GLIBCXX_SIMD_TRAITS(short, short, 1)
+  _GLIBCXX_SIMD_TRAITS(unsigned short, short, 1)
+  _GLIBCXX_SIMD_TRAITS(int, int, 1)
+  _GLIBCXX_SIMD_TRAITS(unsigned int, int, 1)
+  _GLIBCXX_SIMD_TRAITS(long, long, 1)
+  _GLIBCXX_SIMD_TRAITS(unsigned long, long, 1)
+  _GLIBCXX_SIMD_TRAITS(long long, long long, 1)
+  _GLIBCXX_SIMD_TRAITS(unsigned long long, long long, 1)
+  _GLIBCXX_SIMD_TRAITS(float, int, 0)
+  _GLIBCXX_SIMD_TRAITS(double, long long, 0)
+
+#undef _GLIBCXX_SIMD_TRAITS
+#endif
+
+  /**
+   *  @if maint
+   *  Recognizes iterators over contiguous storage of a vectorizable
+   *  type -- plain pointers and the __normal_iterator wrappers used by
+   *  vector and basic_string -- and maps them to raw pointers.
+   *  @endif
+   */
+  template<typename _Iterator>
+    struct __simd_iter
+    {
+      enum { __value = 0 };
+    };
+
+  template<typename _Tp>
+    struct __simd_iter<_Tp*>
+    {
+      enum { __value = __simd_traits<_Tp>::__value };
+
+      static _Tp*
+      _S_base(_Tp* __i)
+      { return __i; }
+    };
+
+  template<typename _Tp>
+    struct __simd_iter<const _Tp*>
+    {
+      enum { __value = __simd_traits<_Tp>::__value };
+
+      static const _Tp*
+      _S_base(const _Tp* __i)
+      { return __i; }
+    };
+
+  template<typename _Iterator, typename _Container>
+    struct __simd_iter<__gnu_cxx::__normal_iterator<_Iterator, _Container> >
+    : public __simd_iter<_Iterator>
+    {
+      static _Iterator
+      _S_base(const __gnu_cxx::__normal_iterator<_Iterator, _Container>& __i)
+      { return __i.base(); }
+    };
+
+  // Unaligned load of one vector's worth of elements.
+  template<typename _Tp>
+    inline typename __simd_traits<_Tp>::__vec
+    __simd_load(const _Tp* __p)
+    {
+      typename __simd_traits<_Tp>::__vec __v;
+      __builtin_memcpy(&__v, __p, sizeof(__v));
+      return __v;
+    }
+
+  // Unaligned store of one vector's worth of elements.
+  template<typename _Tp>
+    inline void
+    __simd_store(_Tp* __p, typename __simd_traits<_Tp>::__vec __v)
+    { __builtin_memcpy(__p, &__v, sizeof(__v)); }
+
+  template<typename _Tp>
+    inline typename __simd_traits<_Tp>::__vec
+    __simd_splat(_Tp __x)
+    {
+      typename __simd_traits<_Tp>::__vec __v;
+      for (int __i = 0; __i < __simd_traits<_Tp>::__lanes; ++__i)
+	__v[__i] = __x;
+      return __v;
+    }
+
+  // True if any lane of the comparison result __m is set.
+  template<typename _Mask>
+    inline bool
+    __simd_any(_Mask __m)
+    {
+      typedef long long _Words
+	__attribute__((__vector_size__(_GLIBCXX_SIMD_WIDTH)));
+      const _Words __w = (_Words)__m;
+      long long __r = __w[0];
+      for (int __i = 1; __i < int(sizeof(_Words) / sizeof(long long)); ++__i)
+	__r |= __w[__i];
+      return __r != 0;
+    }
+
+  /**
+   *  @if maint
+   *  The first element of [first, last) equal to val, or last.  Four
+   *  vectors are compared per step and only a block that contains a
+   *  match is scanned element by element.
+   *  @endif
+   */
+  template<typename _Tp>
+    const _Tp*
+    __simd_find(const _Tp* __first, const _Tp* __last, const _Tp& __val)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+      const _Vec __key = std::__simd_splat(__val);
+
+      for (; __last - __first >= 4 * __lanes; __first += 4 * __lanes)
+	{
+	  const _Mask __m =
+	    ((_Mask)(std::__simd_load(__first) == __key)
+	     | (_Mask)(std::__simd_load(__first + __lanes) == __key)
+	     | (_Mask)(std::__simd_load(__first + 2 * __lanes) == __key)
+	     | (_Mask)(std::__simd_load(__first + 3 * __lanes) == __key));
+	  if (__builtin_expect(std::__simd_any(__m), false))
+	    break;
+	}
+      for (; __last - __first >= __lanes; __first += __lanes)
+	if (std::__simd_any((_Mask)(std::__simd_load(__first) == __key)))
+	  break;
+      while (__first != __last && !(*__first == __val))
+	++__first;
+      return __first;
+    }
+
+  /**
+   *  @if maint
+   *  The first element of [first, last) less than val, or last: the
+   *  threshold test of the top-k selections, which only stop for an
+   *  element that displaces one already chosen.
+   *  @endif
+   */
+  template<typename _Tp>
+    const _Tp*
+    __simd_find_less(const _Tp* __first, const _Tp* __last, const _Tp& __val)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+      const _Vec __key = std::__simd_splat(__val);
+
+      for (; __last - __first >= 4 * __lanes; __first += 4 * __lanes)
+	{
+	  const _Mask __m =
+	    ((_Mask)(std::__simd_load(__first) < __key)
+	     | (_Mask)(std::__simd_load(__first + __lanes) < __key)
+	     | (_Mask)(std::__simd_load(__first + 2 * __lanes) < __key)
+	     | (_Mask)(std::__simd_load(__first + 3 * __lanes) < __key));
+	  if (__builtin_expect(std::__simd_any(__m), false))
+	    break;
+	}
+      for (; __last - __first >= __lanes; __first += __lanes)
+	if (std::__simd_any((_Mask)(std::__simd_load(__first) < __key)))
+	  break;
+      while (__first != __last && !(*__first < __val))
+	++__first;
+      return __first;
+    }
+
+  /**
+   *  @if maint
+   *  The first occurrence of [first2, last2) in [first1, last1), or
+   *  last1, for byte types and a pattern of at least two elements.
+   *  Each step compares a vector of candidate positions against the
+   *  first element of the pattern and, at the pattern's length further
+   *  on, against its last; only the positions that pass both tests are
+   *  compared in full.
+   *  @endif
+   */
+  template<typename _Tp>
+    const _Tp*
+    __simd_search(const _Tp* __first1, const _Tp* __last1,
+		  const _Tp* __first2, const _Tp* __last2)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+      const ptrdiff_t __len = __last2 - __first2;
+      const _Vec __head = std::__simd_splat(__first2[0]);
+      const _Vec __tail = std::__simd_splat(__first2[__len - 1]);
+
+      for (; __last1 - __first1 >= __lanes + __len - 1; __first1 += __lanes)
+	{
+	  const _Mask __hits =
+	    ((_Mask)(std::__simd_load(__first1) == __head)
+	     & (_Mask)(std::__simd_load(__first1 + __len - 1) == __tail));
+	  if (__builtin_expect(std::__simd_any(__hits), false))
+	    for (ptrdiff_t __i = 0; __i < __lanes; ++__i)
+	      if (__hits[__i]
+		  && __builtin_memcmp(__first1 + __i + 1, __first2 + 1,
+				      __len - 2) == 0)
+		return __first1 + __i;
+	}
+      for (; __last1 - __first1 >= __len; ++__first1)
+	if (*__first1 == *__first2
+	    && __builtin_memcmp(__first1 + 1, __first2 + 1, __len - 1) == 0)
+	  return __first1;
+      return __last1;
+    }
+
+  /**
+   *  @if maint
+   *  The number of elements of [first, last) equal to val.  Matches are
+   *  tallied in per-lane counters, which are folded into the result
+   *  before they can overflow.
+   *  @endif
+   */
+  template<typename _Tp>
+    ptrdiff_t
+    __simd_count(const _Tp* __first, const _Tp* __last, const _Tp& __val)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+      const ptrdiff_t __max_rounds = (sizeof(_Tp) >= 4 ? ptrdiff_t(1) << 30
+				      : (ptrdiff_t(1)
+					 << (8 * sizeof(_Tp) - 1)) - 1);
+      const _Vec __key = std::__simd_splat(__val);
+
+      ptrdiff_t __n = 0;
+      while (__last - __first >= __lanes)
+	{
+	  _Mask __acc = (_Mask)std::__simd_splat(_Tp());
+	  for (ptrdiff_t __r = 0;
+	       __r < __max_rounds && __last - __first >= __lanes;
+	       ++__r, __first += __lanes)
+	    __acc -= (_Mask)(std::__simd_load(__first) == __key);
+	  for (ptrdiff_t __i = 0; __i < __lanes; ++__i)
+	    __n += __acc[__i];
+	}
+      for (; __first != __last; ++__first)
+	if (*__first == __val)
+	  ++__n;
+      return __n;
+    }
+
+  /**
+   *  @if maint
+   *  The first position in [first1, last1) whose element differs, by
+   *  operator==, from the corresponding one of [first2, ...), or last1.
+   *  @endif
+   */
+  template<typename _Tp>
+    const _Tp*
+    __simd_mismatch(const _Tp* __first1, const _Tp* __last1,
+		    const _Tp* __first2)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      for (; __last1 - __first1 >= 2 * __lanes;
+	   __first1 += 2 * __lanes, __first2 += 2 * __lanes)
+	{
+	  const _Mask __m =
+	    ((_Mask)(std::__simd_load(__first1) != std::__simd_load(__first2))
+	     | (_Mask)(std::__simd_load(__first1 + __lanes)
+		       != std::__simd_load(__first2 + __lanes)));
+	  if (__builtin_expect(std::__simd_any(__m), false))
+	    break;
+	}
+      while (__first1 != __last1 && *__first1 == *__first2)
+	{
+	  ++__first1;
+	  ++__first2;
+	}
+      return __first1;
+    }
+
+  // Lane-wise __a where __m is set and __b elsewhere.
+  template<typename _Vec, typename _Mask>
+    inline _Vec
+    __simd_select(_Mask __m, _Vec __a, _Vec __b)
+    { return (_Vec)((__m & (_Mask)__a) | (~__m & (_Mask)__b)); }
+
+  /**
+   *  @if maint
+   *  Lane-wise and scalar forms of min and max, for the reductions
+   *  below.  _S_better(a, b) is true when a should replace b.
+   *  @endif
+   */
+  template<typename _Tp>
+    struct __simd_min
+    {
+      typedef typename __simd_traits<_Tp>::__vec  _Vec;
+      typedef typename __simd_traits<_Tp>::__mask _Mask;
+
+      static _Vec
+      _S_vec(_Vec __a, _Vec __b)
+      { return std::__simd_select((_Mask)(__a < __b), __a, __b); }
+
+      static bool
+      _S_better(const _Tp& __a, const _Tp& __b)
+      { return __a < __b; }
+    };
+
+  template<typename _Tp>
+    struct __simd_max
+    {
+      typedef typename __simd_traits<_Tp>::__vec  _Vec;
+      typedef typename __simd_traits<_Tp>::__mask _Mask;
+
+      static _Vec
+      _S_vec(_Vec __a, _Vec __b)
+      { return std::__simd_select((_Mask)(__b < __a), __a, __b); }
+
+      static bool
+      _S_better(const _Tp& __a, const _Tp& __b)
+      { return __b < __a; }
+    };
+
+  // The smallest (largest) value of the non-empty range [first, last).
+  template<typename _Op, typename _Tp>
+    _Tp
+    __simd_reduce_extremum(const _Tp* __first, const _Tp* __last)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      _Tp __r = *__first;
+      if (__last - __first >= 2 * __lanes)
+	{
+	  _Vec __a0 = std::__simd_load(__first);
+	  _Vec __a1 = std::__simd_load(__first + __lanes);
+	  for (__first += 2 * __lanes; __last - __first >= 2 * __lanes;
+	       __first += 2 * __lanes)
+	    {
+	      __a0 = _Op::_S_vec(__a0, std::__simd_load(__first));
+	      __a1 = _Op::_S_vec(__a1, std::__simd_load(__first + __lanes));
+	    }
+	  __a0 = _Op::_S_vec(__a0, __a1);
+	  for (ptrdiff_t __i = 0; __i < __lanes; ++__i)
+	    if (_Op::_S_better(__a0[__i], __r))
+	      __r = __a0[__i];
+	}
+      for (; __first != __last; ++__first)
+	if (_Op::_S_better(*__first, __r))
+	  __r = *__first;
+      return __r;
+    }
+
+  enum { _S_simd_extremum_chunk = 1024 };
+
+  /**
+   *  @if maint
+   *  The first position of the smallest (largest) element of [first,
+   *  last), or last if the range is empty.  The range is reduced one
+   *  chunk at a time, remembering the first chunk to improve on the
+   *  running extremum; the winning position is then found by a search
+   *  of that chunk alone.  Only valid for integral types, for which
+   *  equal values are indistinguishable.
+   *  @endif
+   */
+  template<typename _Op, typename _Tp>
+    const _Tp*
+    __simd_extremum_element(const _Tp* __first, const _Tp* __last)
+    {
+      if (__first == __last)
+	return __last;
+
+      const _Tp* __best_chunk = __first;
+      _Tp __best = *__first;
+      for (const _Tp* __chunk = __first; __chunk != __last;)
+	{
+	  const _Tp* __end = (__last - __chunk > _S_simd_extremum_chunk
+			      ? __chunk + _S_simd_extremum_chunk : __last);
+	  const _Tp __val = std::__simd_reduce_extremum<_Op>(__chunk, __end);
+	  if (_Op::_S_better(__val, __best))
+	    {
+	      __best = __val;
+	      __best_chunk = __chunk;
+	    }
+	  __chunk = __end;
+	}
+      return std::__simd_find(__best_chunk, __last, __best);
+    }
+
+  /**
+   *  @if maint
+   *  Both extrema of the non-empty range [first, last) in one pass: the
+   *  first position of the smallest element and the last position of
+   *  the largest, as the C++0x minmax_element specifies.  Integral types
+   *  only.
+   *  @endif
+   */
+  template<typename _Tp>
+    void
+    __simd_minmax_element(const _Tp* __first, const _Tp* __last,
+			  const _Tp*& __min_pos, const _Tp*& __max_pos)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef __simd_min<_Tp>            _Min;
+      typedef __simd_max<_Tp>            _Max;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      const _Tp* __min_chunk = __first;
+      const _Tp* __max_end = __last;
+      _Tp __min = *__first;
+      _Tp __max = *__first;
+      for (const _Tp* __chunk = __first; __chunk != __last;)
+	{
+	  const _Tp* __end = (__last - __chunk > _S_simd_extremum_chunk
+			      ? __chunk + _S_simd_extremum_chunk : __last);
+	  const _Tp* __p = __chunk;
+	  _Tp __lo = *__p;
+	  _Tp __hi = *__p;
+	  if (__end - __p >= __lanes)
+	    {
+	      _Vec __vlo = std::__simd_load(__p);
+	      _Vec __vhi = __vlo;
+	      for (__p += __lanes; __end - __p >= __lanes; __p += __lanes)
+		{
+		  const _Vec __v = std::__simd_load(__p);
+		  __vlo = _Min::_S_vec(__vlo, __v);
+		  __vhi = _Max::_S_vec(__vhi, __v);
+		}
+	      for (ptrdiff_t __i = 0; __i < __lanes; ++__i)
+		{
+		  if (__vlo[__i] < __lo)
+		    __lo = __vlo[__i];
+		  if (__hi < __vhi[__i])
+		    __hi = __vhi[__i];
+		}
+	    }
+	  for (; __p != __end; ++__p)
+	    {
+	      if (*__p < __lo)
+		__lo = *__p;
+	      if (__hi < *__p)
+		__hi = *__p;
+	    }
+	  if (__lo < __min)
+	    {
+	      __min = __lo;
+	      __min_chunk = __chunk;
+	    }
+	  if (!(__hi < __max))
+	    {
+	      __max = __hi;
+	      __max_end = __end;
+	    }
+	  __chunk = __end;
+	}
+
+      __min_pos = std::__simd_find(__min_chunk, __last, __min);
+      while (!(*--__max_end == __max))
+	{ }
+      __max_pos = __max_end;
+    }
+
+  // Lane-wise sum of a vector, lowest lane first.
+  template<typename _Tp>
+    inline _Tp
+    __simd_reduce_add(typename __simd_traits<_Tp>::__vec __v, _Tp __init)
+    {
+      for (int __i = 0; __i < __simd_traits<_Tp>::__lanes; ++__i)
+	__init = __init + __v[__i];
+      return __init;
+    }
+
+  /**
+   *  @if maint
+   *  init plus the sum of [first, last), kept in four independent
+   *  vector accumulators so consecutive additions do not wait on each
+   *  other.  The additions are reassociated: exact for integral types,
+   *  which wrap the same way in any order, but only approximately equal
+   *  to the sequential sum for floating-point types.
+   *  @endif
+   */
+  template<typename _Tp>
+    _Tp
+    __simd_sum(const _Tp* __first, const _Tp* __last, _Tp __init)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      if (__last - __first >= 4 * __lanes)
+	{
+	  _Vec __a0 = std::__simd_load(__first);
+	  _Vec __a1 = std::__simd_load(__first + __lanes);
+	  _Vec __a2 = std::__simd_load(__first + 2 * __lanes);
+	  _Vec __a3 = std::__simd_load(__first + 3 * __lanes);
+	  for (__first += 4 * __lanes; __last - __first >= 4 * __lanes;
+	       __first += 4 * __lanes)
+	    {
+	      __a0 += std::__simd_load(__first);
+	      __a1 += std::__simd_load(__first + __lanes);
+	      __a2 += std::__simd_load(__first + 2 * __lanes);
+	      __a3 += std::__simd_load(__first + 3 * __lanes);
+	    }
+	  for (; __last - __first >= __lanes; __first += __lanes)
+	    __a0 += std::__simd_load(__first);
+	  __init = std::__simd_reduce_add<_Tp>((__a0 + __a1) + (__a2 + __a3),
+					       __init);
+	}
+      for (; __first != __last; ++__first)
+	__init = __init + *__first;
+      return __init;
+    }
+
+  /**
+   *  @if maint
+   *  init plus the sum of the products of [first1, last1) and [first2,
+   *  ...), reassociated as in __simd_sum.
+   *  @endif
+   */
+  template<typename _Tp>
+    _Tp
+    __simd_dot(const _Tp* __first1, const _Tp* __last1,
+	       const _Tp* __first2, _Tp __init)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      if (__last1 - __first1 >= 4 * __lanes)
+	{
+	  _Vec __a0 = std::__simd_load(__first1) * std::__simd_load(__first2);
+	  _Vec __a1 = (std::__simd_load(__first1 + __lanes)
+		       * std::__simd_load(__first2 + __lanes));
+	  _Vec __a2 = (std::__simd_load(__first1 + 2 * __lanes)
+		       * std::__simd_load(__first2 + 2 * __lanes));
+	  _Vec __a3 = (std::__simd_load(__first1 + 3 * __lanes)
+		       * std::__simd_load(__first2 + 3 * __lanes));
+	  for (__first1 += 4 * __lanes, __first2 += 4 * __lanes;
+	       __last1 - __first1 >= 4 * __lanes;
+	       __first1 += 4 * __lanes, __first2 += 4 * __lanes)
+	    {
+	      __a0 += (std::__simd_load(__first1)
+		       * std::__simd_load(__first2));
+	      __a1 += (std::__simd_load(__first1 + __lanes)
+		       * std::__simd_load(__first2 + __lanes));
+	      __a2 += (std::__simd_load(__first1 + 2 * __lanes)
+		       * std::__simd_load(__first2 + 2 * __lanes));
+	      __a3 += (std::__simd_load(__first1 + 3 * __lanes)
+		       * std::__simd_load(__first2 + 3 * __lanes));
+	    }
+	  for (; __last1 - __first1 >= __lanes;
+	       __first1 += __lanes, __first2 += __lanes)
+	    __a0 += std::__simd_load(__first1) * std::__simd_load(__first2);
+	  __init = std::__simd_reduce_add<_Tp>((__a0 + __a1) + (__a2 + __a3),
+					       __init);
+	}
+      for (; __first1 != __last1; ++__first1, ++__first2)
+	__init = __init + *__first1 * *__first2;
+      return __init;
+    }
+
+  // The merge step of __simd_set_intersection, up to the end of either
+  // range.  Only a match branches; the two pointers advance by the
+  // results of the comparisons.
+  template<typename _Tp, typename _OutputIterator>
+    inline _OutputIterator
+    __simd_merge_common(const _Tp*& __first1, const _Tp* __last1,
+			const _Tp*& __first2, const _Tp* __last2,
+			_OutputIterator __result)
+    {
+      while (__first1 != __last1 && __first2 != __last2)
+	{
+	  const _Tp __x = *__first1;
+	  const _Tp __y = *__first2;
+	  if (__x == __y)
+	    {
+	      *__result = __x;
+	      ++__result;
+	    }
+	  __first1 += !(__y < __x);
+	  __first2 += !(__x < __y);
+	}
+      return __result;
+    }
+
+  /**
+   *  @if maint
+   *  set_intersection of two sorted ranges of an integral type.  One
+   *  block of each range is loaded and every element of the first
+   *  block is compared with the whole of the second.  When no pair is
+   *  equal, the block with the lower last element can meet nothing
+   *  further on in the other range and is skipped whole.  Blocks that
+   *  share a value are merged element by element, which keeps the count
+   *  of equivalent elements that set_intersection requires.
+   *  @endif
+   */
+  template<typename _Tp, typename _OutputIterator>
+    _OutputIterator
+    __simd_set_intersection(const _Tp* __first1, const _Tp* __last1,
+			    const _Tp* __first2, const _Tp* __last2,
+			    _OutputIterator __result)
+    {
+      typedef __simd_traits<_Tp>         _Traits;
+      typedef typename _Traits::__vec    _Vec;
+      typedef typename _Traits::__mask   _Mask;
+      const ptrdiff_t __lanes = _Traits::__lanes;
+
+      while (__last1 - __first1 >= __lanes && __last2 - __first2 >= __lanes)
+	{
+	  const _Vec __block2 = std::__simd_load(__first2);
+	  _Mask __m = (_Mask)(std::__simd_splat(__first1[0]) == __block2);
+	  for (ptrdiff_t __i = 1; __i < __lanes; ++__i)
+	    __m |= (_Mask)(std::__simd_splat(__first1[__i]) == __block2);
+
+	  if (!std::__simd_any(__m))
+	    {
+	      // The two last elements differ, or they would have matched.
+	      const bool __low1 = (__first1[__lanes - 1]
+				   < __first2[__lanes - 1]);
+	      __first1 += __low1 ? __lanes : 0;
+	      __first2 += __low1 ? 0 : __lanes;
+	      continue;
+	    }
+
+	  __result = std::__simd_merge_common(__first1, __first1 + __lanes,
+					      __first2, __first2 + __lanes,
+					      __result);
+	}
+      return std::__simd_merge_common(__first1, __last1, __first2, __last2,
+				      __result);
+    }
+
+  // The lanes of __v in reverse order.  Clang has no __builtin_shuffle,
+  // but folds the lane-by-lane copy into a single shuffle.
+  template<typename _Tp>
+    inline typename __simd_traits<_Tp>::__vec
+    __simd_reverse_lanes(typename __simd_traits<_Tp>::__vec __v)
+    {
+      typedef __simd_traits<_Tp> _Traits;
+      const int __lanes = _Traits::__lanes;
+#if _GLIBCXX_USE_SIMD && defined(__SSE2__) && !defined(__SSSE3__)
+      // SSE2 has no byte shuffle: reverse the 16-bit lanes, then the
+      // two bytes within each.
+      if (sizeof(_Tp) == 1)
+	{
+	  typedef __simd_traits<unsigned short>::__vec _Words;
+	  const _Words __w =
+	    std::__simd_reverse_lanes<unsigned short>((_Words)__v);
+	  return (typename _Traits::__vec)((__w << 8) | (__w >> 8));
+	}
+#endif
+#ifdef __clang__
+      typename _Traits::__vec __r;
+      for (int __i = 0; __i < __lanes; ++__i)
+	__r[__i] = __v[__lanes - 1 - __i];
+      return __r;
+#else
+      typename _Traits::__mask __idx;
+      for (int __i = 0; __i < __lanes; ++__i)
+	__idx[__i] = __lanes - 1 - __i;
+      return __builtin_shuffle(__v, __idx);
+#endif
+    }
+
+  /**
+   *  @if maint
+   *  reverse for contiguous storage: a vector is loaded from each end,
+   *  its lanes reversed, and stored at the other end, until fewer than
+   *  two vectors' worth of elements remain in the middle.
+   *  @endif
+   */
+  template<typename _Tp>
+    void
+    __simd_reverse(_Tp* __first, _Tp* __last)
+    {
+      typedef typename __simd_traits<_Tp>::__vec _Vec;
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+
+      for (; __last - __first >= 2 * __lanes;
+	   __first += __lanes, __last -= __lanes)
+	{
+	  const _Vec __head = std::__simd_load(__first);
+	  const _Vec __tail = std::__simd_load(__last - __lanes);
+	  std::__simd_store(__first, std::__simd_reverse_lanes<_Tp>(__tail));
+	  std::__simd_store(__last - __lanes,
+			    std::__simd_reverse_lanes<_Tp>(__head));
+	}
+      for (; __last - __first > 1; ++__first)
+	{
+	  --__last;
+	  const _Tp __tmp = *__first;
+	  *__first = *__last;
+	  *__last = __tmp;
+	}
+    }
+
+  // swap_ranges for contiguous, non-overlapping storage.
+  template<typename _Tp>
+    _Tp*
+    __simd_swap_ranges(_Tp* __first1, _Tp* __last1, _Tp* __first2)
+    {
+      typedef typename __simd_traits<_Tp>::__vec _Vec;
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+
+      for (; __last1 - __first1 >= 2 * __lanes;
+	   __first1 += 2 * __lanes, __first2 += 2 * __lanes)
+	{
+	  const _Vec __a0 = std::__simd_load(__first1);
+	  const _Vec __a1 = std::__simd_load(__first1 + __lanes);
+	  const _Vec __b0 = std::__simd_load(__first2);
+	  const _Vec __b1 = std::__simd_load(__first2 + __lanes);
+	  std::__simd_store(__first1, __b0);
+	  std::__simd_store(__first1 + __lanes, __b1);
+	  std::__simd_store(__first2, __a0);
+	  std::__simd_store(__first2 + __lanes, __a1);
+	}
+      for (; __first1 != __last1; ++__first1, ++__first2)
+	{
+	  const _Tp __tmp = *__first1;
+	  *__first1 = *__first2;
+	  *__first2 = __tmp;
+	}
+      return __first2;
+    }
+
+#if _GLIBCXX_USE_SIMD
+  // The vector population count beats a scalar popcnt instruction only
+  // with 32-byte vectors; ARM's scalar count already uses NEON.
+#ifndef _GLIBCXX_SIMD_POPCOUNT
+# if defined(__SSE2__) && (!defined(__POPCNT__) || _GLIBCXX_SIMD_WIDTH == 32)
+#  define _GLIBCXX_SIMD_POPCOUNT 1
+# else
+#  define _GLIBCXX_SIMD_POPCOUNT 0
+# endif
+#endif
+
+  /**
+   *  @if maint
+   *  Kernels over arrays of unsigned words, for bitset.  The population
+   *  counts add up the per-byte counts of each vector in a register,
+   *  where a byte can take 31 vectors before it could overflow, and
+   *  only then widen them to a word.  _And selects the count of the
+   *  bitwise and of two arrays, so that no temporary is written.
+   *  @endif
+   */
+  template<bool _And, typename _Tp>
+    size_t
+    __simd_popcount_words(const _Tp* __first, const _Tp* __last,
+			  const _Tp* __first2)
+    {
+      typedef unsigned long long _Word;
+      typedef typename __simd_traits<_Tp>::__vec    _Vec;
+      typedef typename __simd_traits<_Word>::__vec  _Wvec;
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+      const _Wvec __m1 = std::__simd_splat(0x5555555555555555ULL);
+      const _Wvec __m2 = std::__simd_splat(0x3333333333333333ULL);
+      const _Wvec __m4 = std::__simd_splat(0x0f0f0f0f0f0f0f0fULL);
+      const _Wvec __m8 = std::__simd_splat(0x00ff00ff00ff00ffULL);
+      const _Wvec __m16 = std::__simd_splat(0x0000ffff0000ffffULL);
+      const _Wvec __m32 = std::__simd_splat(0x00000000ffffffffULL);
+
+      _Wvec __total = std::__simd_splat(_Word(0));
+      while (__last - __first >= __lanes)
+	{
+	  _Wvec __acc = std::__simd_splat(_Word(0));
+	  for (int __r = 0; __r < 31 && __last - __first >= __lanes;
+	       ++__r, __first += __lanes, __first2 += __lanes)
+	    {
+	      _Vec __x = std::__simd_load(__first);
+	      if (_And)
+		__x &= std::__simd_load(__first2);
+	      _Wvec __v = (_Wvec)__x;
+	      __v -= (__v >> 1) & __m1;
+	      __v = (__v & __m2) + ((__v >> 2) & __m2);
+	      __acc += (__v + (__v >> 4)) & __m4;
+	    }
+	  __acc = (__acc & __m8) + ((__acc >> 8) & __m8);
+	  __acc = (__acc & __m16) + ((__acc >> 16) & __m16);
+	  __total += (__acc & __m32) + (__acc >> 32);
+	}
+
+      size_t __n = std::__simd_reduce_add<_Word>(__total, 0);
+      for (; __first != __last; ++__first, ++__first2)
+	__n += __builtin_popcountll(_And ? *__first & *__first2 : *__first);
+      return __n;
+    }
+
+  // Whether [first, last) and [first2, ...) have a set bit in common.
+  template<typename _Tp>
+    bool
+    __simd_any_and(const _Tp* __first, const _Tp* __last,
+		   const _Tp* __first2)
+    {
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+
+      for (; __last - __first >= 2 * __lanes;
+	   __first += 2 * __lanes, __first2 += 2 * __lanes)
+	if (std::__simd_any((std::__simd_load(__first)
+			     & std::__simd_load(__first2))
+			    | (std::__simd_load(__first + __lanes)
+			       & std::__simd_load(__first2 + __lanes))))
+	  return true;
+      for (; __first != __last; ++__first, ++__first2)
+	if (*__first & *__first2)
+	  return true;
+      return false;
+    }
+
+  // The first nonzero element of [first, last), or last.
+  template<typename _Tp>
+    const _Tp*
+    __simd_find_nonzero(const _Tp* __first, const _Tp* __last)
+    {
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+
+      for (; __last - __first >= 4 * __lanes; __first += 4 * __lanes)
+	if (std::__simd_any(std::__simd_load(__first)
+			    | std::__simd_load(__first + __lanes)
+			    | std::__simd_load(__first + 2 * __lanes)
+			    | std::__simd_load(__first + 3 * __lanes)))
+	  break;
+      while (__first != __last && *__first == 0)
+	++__first;
+      return __first;
+    }
+
+  /**
+   *  @if maint
+   *  The word loops of a bitset shift by a count that is not a whole
+   *  number of words: words [wshift + 1, n) of w, highest first, become
+   *  (w[i - wshift] << offset) | (w[i - wshift - 1] >> (bits - offset)),
+   *  and for the right shift words [0, n - wshift - 1), lowest first,
+   *  become (w[i + wshift] >> offset) | (w[i + wshift + 1] << (bits -
+   *  offset)).  Each block is loaded before it is stored, so the shift
+   *  can be done in place.  0 < offset < bits.
+   *  @endif
+   */
+  template<typename _Tp>
+    void
+    __simd_shift_words_up(_Tp* __w, size_t __n, size_t __wshift,
+			  unsigned int __offset)
+    {
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+      const unsigned int __sub = 8 * sizeof(_Tp) - __offset;
+
+      ptrdiff_t __i = ptrdiff_t(__n);
+      for (; __i - __lanes > ptrdiff_t(__wshift); __i -= __lanes)
+	{
+	  const _Tp* __src = __w + (__i - __lanes - __wshift);
+	  std::__simd_store(__w + (__i - __lanes),
+			    (std::__simd_load(__src) << __offset)
+			    | (std::__simd_load(__src - 1) >> __sub));
+	}
+      for (--__i; __i > ptrdiff_t(__wshift); --__i)
+	__w[__i] = ((__w[__i - __wshift] << __offset)
+		    | (__w[__i - __wshift - 1] >> __sub));
+    }
+
+  template<typename _Tp>
+    void
+    __simd_shift_words_down(_Tp* __w, size_t __n, size_t __wshift,
+			    unsigned int __offset)
+    {
+      const ptrdiff_t __lanes = __simd_traits<_Tp>::__lanes;
+      const unsigned int __sub = 8 * sizeof(_Tp) - __offset;
+      const ptrdiff_t __limit = ptrdiff_t(__n - __wshift - 1);
+
+      ptrdiff_t __i = 0;
+      for (; __limit - __i >= __lanes; __i += __lanes)
+	{
+	  const _Tp* __src = __w + (__i + __wshift);
+	  std::__simd_store(__w + __i,
+			    (std::__simd_load(__src) >> __offset)
+			    | (std::__simd_load(__src + 1) << __sub));
+	}
+      for (; __i < __limit; ++__i)
+	__w[__i] = ((__w[__i + __wshift] >> __offset)
+		    | (__w[__i + __wshift + 1] << __sub));
+    }
+#endif
+
+#if _GLIBCXX_USE_SIMD && defined(__AVX2__) && _GLIBCXX_SIMD_WIDTH == 32
+# define _GLIBCXX_SIMD_COMPRESS 1
+
+  /**
+   *  @if maint
+   *  For each subset of the _Lanes lanes of a 32-byte vector, the
+   *  indices of the 32-bit words of the lanes in the subset, in order:
+   *  the permutation that packs them at the bottom of the vector.
+   *  Built on first use.
+   *  @endif
+   */
+  template<int _Lanes>
+    struct __simd_compress_table
+    {
+      typedef int __index __attribute__((__vector_size__(32)));
+
+      __index _M_perm[1 << _Lanes];
+
+      __simd_compress_table()
+      {
+	const int __words = 8 / _Lanes;
+	for (int __m = 0; __m < (1 << _Lanes); ++__m)
+	  {
+	    int __k = 0;
+	    for (int __i = 0; __i < _Lanes; ++__i)
+	      if (__m & (1 << __i))
+		for (int __w = 0; __w < __words; ++__w)
+		  _M_perm[__m][__k++] = __i * __words + __w;
+	    for (; __k < 8; ++__k)
+	      _M_perm[__m][__k] = 0;
+	  }
+      }
+
+      static const __index&
+      _S_perm(int __m)
+      {
+	static const __simd_compress_table __table;
+	return __table._M_perm[__m];
+      }
+    };
+
+  /**
+   *  @if maint
+   *  Stores the lanes of __v for which __m is set contiguously at __out
+   *  and returns the end of them; the rest of the vector's worth of
+   *  elements at __out is overwritten.  For lanes of four or eight
+   *  bytes: the lanes are packed by one permutation, looked up by the
+   *  bits of __m.
+   *  @endif
+   */
+  template<typename _Tp>
+    inline _Tp*
+    __simd_compress_store(_Tp* __out, typename __simd_traits<_Tp>::__vec __v,
+			  typename __simd_traits<_Tp>::__mask __m)
+    {
+      typedef int _Words __attribute__((__vector_size__(32)));
+      typedef float _Floats __attribute__((__vector_size__(32)));
+      typedef double _Doubles __attribute__((__vector_size__(32)));
+      typedef __simd_compress_table<(sizeof(_Tp) >= 4
+				     ? int(__simd_traits<_Tp>::__lanes)
+				     : 1)> _Table;
+
+      const int __bits = (sizeof(_Tp) == 4
+			  ? __builtin_ia32_movmskps256((_Floats)__m)
+			  : __builtin_ia32_movmskpd256((_Doubles)__m));
+      const _Words __packed =
+	__builtin_ia32_permvarsi256((_Words)__v, _Table::_S_perm(__bits));
+      __builtin_memcpy(__out, &__packed, sizeof(__packed));
+      return __out + __builtin_popcount(__bits);
+    }
+#else
+# define _GLIBCXX_SIMD_COMPRESS 0
+#endif
+
+  /**
+   *  @if maint
+   *  remove_copy from contiguous storage: the elements of [first, last)
+   *  not equal to val, to out.  out may be first, or anywhere before
+   *  it, or a buffer of last - first elements, since every element is
+   *  stored and out advanced only past those kept.  Where
+   *  __simd_compress_store applies, a vector is compared and packed at
+   *  a time; elsewhere packing lane by lane was measured slower than
+   *  the scalar loop.
+   *  @endif
+   */
+  template<typename _Tp>
+    _Tp*
+    __simd_remove_copy(const _Tp* __first, const _Tp* __last, _Tp* __out,
+		       const _Tp& __val)
+    {
+#if _GLIBCXX_SIMD_COMPRESS
+      if (sizeof(_Tp) >= 4)
+	{
+	  typedef __simd_traits<_Tp>         _Traits;
+	  typedef typename _Traits::__vec    _Vec;
+	  typedef typename _Traits::__mask   _Mask;
+	  const ptrdiff_t __lanes = _Traits::__lanes;
+	  const _Vec __key = std::__simd_splat(__val);
+
+	  for (; __last - __first >= __lanes; __first += __lanes)
+	    {
+	      const _Vec __v = std::__simd_load(__first);
+	      __out = std::__simd_compress_store(__out, __v,
+						 (_Mask)(__v != __key));
+	    }
+	}
+#endif
+      for (; __first != __last; ++__first)
+	{
+	  const _Tp __x = *__first;
+	  *__out = __x;
+	  __out += !(__x == __val);
+	}
+      return __out;
+    }
+
+  /**
+   *  @if maint
+   *  unique_copy from contiguous storage: the elements of [first, last)
+   *  not equal to the one before them, to out.  first[-1] must exist.
+   *  out may be anywhere before first, or a buffer of last - first
+   *  elements; since it then trails first by at least one, no store
+   *  reaches an element still to be compared.
+   *  @endif
+   */
+  template<typename _Tp>
+    _Tp*
+    __simd_unique_copy(const _Tp* __first, const _Tp* __last, _Tp* __out)
+    {
+#if _GLIBCXX_SIMD_COMPRESS
+      if (sizeof(_Tp) >= 4)
+	{
+	  typedef __simd_traits<_Tp>         _Traits;
+	  typedef typename _Traits::__vec    _Vec;
+	  typedef typename _Traits::__mask   _Mask;
+	  const ptrdiff_t __lanes = _Traits::__lanes;
+
+	  for (; __last - __first >= __lanes; __first += __lanes)
+	    {
+	      const _Vec __v = std::__simd_load(__first);
+	      const _Vec __prev = std::__simd_load(__first - 1);
+	      __out = std::__simd_compress_store(__out, __v,
+						 (_Mask)(__v != __prev));
+	    }
+	}
+#endif
+      for (; __first != __last; ++__first)
+	{
+	  const _Tp __x = *__first;
+	  const bool __keep = !(__x == __first[-1]);
+	  *__out = __x;
+	  __out += __keep;
+	}
+      return __out;
+    }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif /* _STL_SIMD_H */
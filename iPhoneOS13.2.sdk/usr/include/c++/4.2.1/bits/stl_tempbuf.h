@@ -63,14 +63,211 @@
 #define _TEMPBUF_H 1
 
 #include <memory>
+#include <bits/gthr.h>
+
+// Largest scratch block, in bytes, that a thread keeps between
+// _Temporary_buffer requests.  Zero turns the cache off.
+#ifndef _GLIBCXX_TEMPBUF_CACHE_MAX
+# define _GLIBCXX_TEMPBUF_CACHE_MAX (1 << 20)
+#endif
 
 _GLIBCXX_BEGIN_NAMESPACE(std)
 
+  /**
+   *  @if maint
+   *  A per-thread cache of one scratch block for _Temporary_buffer.
+   *  stable_sort, stable_partition and inplace_merge ask for a buffer
+   *  on every call and free it on return; instead of being freed, the
+   *  block is kept if it is no larger than _S_limit() bytes, and hands
+   *  out the next request it is big enough for.  A request it cannot
+   *  serve frees it and allocates as get_temporary_buffer does.  A
+   *  block in use is out of the cache, so a nested request (made by a
+   *  comparison, say) allocates its own, and the larger of the two is
+   *  kept when they come back.
+   *
+   *  The counters cover the calling thread only; see
+   *  __gnu_cxx::temporary_buffer_cache_stats in ext/memory.
+   *  @endif
+   */
+  struct __tempbuf_cache
+  {
+    void*  _M_block;
+    size_t _M_bytes;
+    size_t _M_hits;
+    size_t _M_misses;
+    size_t _M_discards;
+
+    // The high-water mark.  Meant to be set before threads start.
+    static size_t&
+    _S_limit()
+    {
+      static size_t __limit = _GLIBCXX_TEMPBUF_CACHE_MAX;
+      return __limit;
+    }
+
+    // The calling thread's cache, or 0 if it cannot have one.
+    static __tempbuf_cache*
+    _S_get()
+    {
+#ifdef __GTHREADS
+      if (__gthread_active_p())
+	{
+	  // On some platforms, __gthread_once_t is an aggregate.
+	  static __gthread_once_t __once = __GTHREAD_ONCE_INIT;
+	  __gthread_once(&__once, _S_make_key);
+	  if (!_S_key_valid())
+	    return 0;
+
+	  __tempbuf_cache* __c = static_cast<__tempbuf_cache*>
+	    (__gthread_getspecific(_S_key()));
+	  if (!__c)
+	    {
+	      __c = static_cast<__tempbuf_cache*>
+		(::operator new(sizeof(__tempbuf_cache), nothrow));
+	      if (!__c)
+		return 0;
+	      __c->_M_clear();
+	      if (__gthread_setspecific(_S_key(), __c) != 0)
+		{
+		  ::operator delete(__c, nothrow);
+		  return 0;
+		}
+	    }
+	  return __c;
+	}
+#endif
+      static __tempbuf_cache __single;
+      return &__single;
+    }
+
+    void
+    _M_clear()
+    {
+      _M_block = 0;
+      _M_bytes = 0;
+      _M_hits = 0;
+      _M_misses = 0;
+      _M_discards = 0;
+    }
+
+    // Frees the cached block, if any.
+    void
+    _M_release()
+    {
+      if (_M_block)
+	{
+	  ::operator delete(_M_block, nothrow);
+	  _M_block = 0;
+	  _M_bytes = 0;
+	  ++_M_discards;
+	}
+    }
+
+    // Takes back a block of __bytes bytes, keeping the larger of it
+    // and the cached one if it is under the limit.
+    void
+    _M_put(void* __p, size_t __bytes)
+    {
+      if (__bytes > _M_bytes && __bytes <= _S_limit())
+	{
+	  _M_release();
+	  _M_block = __p;
+	  _M_bytes = __bytes;
+	}
+      else
+	{
+	  ::operator delete(__p, nothrow);
+	  ++_M_discards;
+	}
+    }
+
+  private:
+#ifdef __GTHREADS
+    static __gthread_key_t&
+    _S_key()
+    {
+      static __gthread_key_t __key;
+      return __key;
+    }
+
+    static bool&
+    _S_key_valid()
+    {
+      static bool __valid;
+      return __valid;
+    }
+
+    static void
+    _S_make_key()
+    { _S_key_valid() = __gthread_key_create(&_S_key(), _S_destroy) == 0; }
+
+    // Runs at thread exit.
+    static void
+    _S_destroy(void* __p)
+    {
+      __tempbuf_cache* __c = static_cast<__tempbuf_cache*>(__p);
+      __c->_M_release();
+      ::operator delete(__c, nothrow);
+    }
+#endif
+  };
+
+  /**
+   *  @if maint
+   *  get_temporary_buffer through the calling thread's cache.  Sets
+   *  __bytes to the size of the block returned, which may be larger
+   *  than asked for, and which __return_cached_buffer must be given.
+   *  @endif
+   */
+  template<typename _Tp>
+    pair<_Tp*, ptrdiff_t>
+    __get_cached_buffer(ptrdiff_t __len, size_t& __bytes)
+    {
+      __bytes = 0;
+      if (__len <= 0)
+	return pair<_Tp*, ptrdiff_t>(static_cast<_Tp*>(0), 0);
+
+      if (__tempbuf_cache* __c = __tempbuf_cache::_S_get())
+	{
+	  if (__c->_M_block
+	      && size_t(__len) <= __c->_M_bytes / sizeof(_Tp))
+	    {
+	      _Tp* __tmp = static_cast<_Tp*>(__c->_M_block);
+	      __bytes = __c->_M_bytes;
+	      __c->_M_block = 0;
+	      __c->_M_bytes = 0;
+	      ++__c->_M_hits;
+	      return pair<_Tp*, ptrdiff_t>(__tmp, __len);
+	    }
+	  ++__c->_M_misses;
+	  __c->_M_release();
+	}
+
+      pair<_Tp*, ptrdiff_t> __p(std::get_temporary_buffer<_Tp>(__len));
+      __bytes = __p.second * sizeof(_Tp);
+      return __p;
+    }
+
+  inline void
+  __return_cached_buffer(void* __p, size_t __bytes)
+  {
+    if (!__p)
+      return;
+    if (__tempbuf_cache* __c = __tempbuf_cache::_S_get())
+      __c->_M_put(__p, __bytes);
+    else
+      ::operator delete(__p, nothrow);
+  }
+
   /**
    *  @if maint
    *  This class is used in two places: stl_algo.h and ext/memory,
    *  where it is wrapped as the temporary_buffer class.  See
    *  temporary_buffer docs for more notes.
+   *
+   *  The storage comes from the calling thread's __tempbuf_cache, so
+   *  a loop of stable_sort calls reuses one block instead of
+   *  allocating and freeing it every time.
    *  @endif
    */
   template<typename _ForwardIterator, typename _Tp>
@@ -89,6 +286,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       size_type  _M_original_len;
       size_type  _M_len;
       pointer    _M_buffer;
+      size_t     _M_bytes;   // of the block, which may exceed _M_len
 
       void
       _M_initialize_buffer(const _Tp&, __true_type) { }
@@ -127,7 +325,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       ~_Temporary_buffer()
       {
 	std::_Destroy(_M_buffer, _M_buffer + _M_len);
-	std::return_temporary_buffer(_M_buffer);
+	std::__return_cached_buffer(_M_buffer, _M_bytes);
       }
 
     private:
@@ -143,15 +341,15 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Temporary_buffer<_ForwardIterator, _Tp>::
     _Temporary_buffer(_ForwardIterator __first, _ForwardIterator __last)
     : _M_original_len(std::distance(__first, __last)),
-      _M_len(0), _M_buffer(0)
+      _M_len(0), _M_buffer(0), _M_bytes(0)
     {
       // Workaround for a __type_traits bug in the pre-7.3 compiler.
       typedef typename std::__is_scalar<_Tp>::__type _Trivial;
 
       try
 	{
-	  pair<pointer, size_type> __p(get_temporary_buffer<
-				       value_type>(_M_original_len));
+	  pair<pointer, size_type> __p(std::__get_cached_buffer<
+				       value_type>(_M_original_len, _M_bytes));
 	  _M_buffer = __p.first;
 	  _M_len = __p.second;
 	  if (_M_len > 0)
@@ -159,7 +357,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	}
       catch(...)
 	{
-	  std::return_temporary_buffer(_M_buffer);
+	  std::__return_cached_buffer(_M_buffer, _M_bytes);
 	  _M_buffer = 0;
 	  _M_len = 0;
 	  __throw_exception_again;
@@ -294,6 +294,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Expr<_Clos, _Tp>::sum() const
     {
       size_t __n = _M_closure.size();
+      _Tp __r = _Tp();
+      if (_Array_simd<(__valarray_simd<_Clos>::__value
+		       && __valarray_simd_op<__plus, _Tp>::__value)>::
+	  _S_sum(_M_closure, __n, __r))
+	return __r;
       if (__n == 0)
 	return _Tp();
       else
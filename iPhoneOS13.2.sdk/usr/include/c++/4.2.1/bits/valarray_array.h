@@ -45,6 +45,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <new>
+#include <bits/stl_simd.h>
+#ifdef _GLIBCXX_VALARRAY_PARALLEL
+# include <ext/thread_pool.h>
+#endif
 
 _GLIBCXX_BEGIN_NAMESPACE(std)
 
@@ -172,6 +176,12 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       _Array_copy_ctor<_Tp, __is_pod<_Tp>::__value>::_S_do_it(__b, __e, __o);
     }
 
+  // Copy strided array __a[<__n : __s>] in plain __b[<__n>]
+  template<typename _Tp>
+    inline void
+    __valarray_copy(const _Tp* __restrict__ __a, size_t __n, size_t __s,
+		    _Tp* __restrict__ __b);
+
   // copy-construct raw array [__o, *) from strided array __a[<__n : __s>]
   template<typename _Tp>
     inline void
@@ -179,11 +189,7 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 			       size_t __s, _Tp* __restrict__ __o)
     {
       if (__is_pod<_Tp>::__value)
-	while (__n--)
-	  {
-	    *__o++ = *__a;
-	    __a += __s;
-	  }
+	std::__valarray_copy(__a, __n, __s, __o);
       else
 	while (__n--)
 	  {
@@ -235,6 +241,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_fill(_Tp* __restrict__ __a, size_t __n,
 		    size_t __s, const _Tp& __t)
     { 
+      if (__s == 1)
+	{
+	  std::__valarray_fill(__a, __n, __t);
+	  return;
+	}
       for (size_t __i = 0; __i < __n; ++__i, __a += __s)
 	*__a = __t;
     }
@@ -279,13 +290,27 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       _Array_copier<_Tp, __is_pod<_Tp>::__value>::_S_do_it(__a, __n, __b);
     }
 
-  // Copy strided array __a[<__n : __s>] in plain __b[<__n>]
+  // Copy strided array __a[<__n : __s>] in plain __b[<__n>].  A unit
+  // stride is a plain copy; other strides are unrolled four times, so
+  // that the loads of a group do not wait on one another.
   template<typename _Tp>
     inline void
     __valarray_copy(const _Tp* __restrict__ __a, size_t __n, size_t __s,
 		    _Tp* __restrict__ __b)
     {
-      for (size_t __i = 0; __i < __n; ++__i, ++__b, __a += __s)
+      if (__s == 1)
+	{
+	  std::__valarray_copy(__a, __n, __b);
+	  return;
+	}
+      for (; __n >= 4; __n -= 4, __b += 4, __a += 4 * __s)
+	{
+	  __b[0] = __a[0];
+	  __b[1] = __a[__s];
+	  __b[2] = __a[2 * __s];
+	  __b[3] = __a[3 * __s];
+	}
+      for (; __n; --__n, ++__b, __a += __s)
 	*__b = *__a;
     }
 
@@ -295,7 +320,19 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(const _Tp* __restrict__ __a, _Tp* __restrict__ __b,
 		    size_t __n, size_t __s)
     {
-      for (size_t __i = 0; __i < __n; ++__i, ++__a, __b += __s)
+      if (__s == 1)
+	{
+	  std::__valarray_copy(__a, __n, __b);
+	  return;
+	}
+      for (; __n >= 4; __n -= 4, __a += 4, __b += 4 * __s)
+	{
+	  __b[0] = __a[0];
+	  __b[__s] = __a[1];
+	  __b[2 * __s] = __a[2];
+	  __b[3 * __s] = __a[3];
+	}
+      for (; __n; --__n, ++__a, __b += __s)
 	*__b = *__a;
     }
 
@@ -306,8 +343,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(const _Tp* __restrict__ __src, size_t __n, size_t __s1,
 		    _Tp* __restrict__ __dst, size_t __s2)
     {
-      for (size_t __i = 0; __i < __n; ++__i)
-	__dst[__i * __s2] = __src[__i * __s1];
+      if (__s2 == 1)
+	std::__valarray_copy(__src, __n, __s1, __dst);
+      else if (__s1 == 1)
+	std::__valarray_copy(__src, __dst, __n, __s2);
+      else
+	for (size_t __i = 0; __i < __n; ++__i)
+	  __dst[__i * __s2] = __src[__i * __s1];
     }
 
   // Copy an indexed array __a[__i[<__n>]] in plain array __b[<__n>]
@@ -343,6 +385,321 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
 	__dst[*__j++] = __src[*__i++];
     }
 
+  //
+  // Vectorized evaluation of valarray expressions
+  //
+
+  // Widest integer type the vector unit multiplies natively.
+#ifndef _GLIBCXX_VALARRAY_SIMD_IMUL
+# if defined(__SSE4_1__) || defined(__ARM_NEON__) || defined(__ARM_NEON)
+#  define _GLIBCXX_VALARRAY_SIMD_IMUL 4
+# else
+#  define _GLIBCXX_VALARRAY_SIMD_IMUL 2
+# endif
+#endif
+
+  // Whether _Oper, applied to vectors of _Tp, computes in each lane
+  // what it computes on the _Tp of that lane.  The scalar operands of
+  // types narrower than int are promoted, which vector lanes are not:
+  // their shifts are left out, and so is the arithmetic of the signed
+  // ones, which may overflow in a lane but not once promoted.  So are
+  // integer division, as no vector unit divides integers, and the
+  // integer multiplications the vector unit would emulate.
+  template<class _Oper, typename _Tp>
+    struct __valarray_simd_op
+    { enum { __value = 0 }; };
+
+  template<typename _Tp>
+    struct __valarray_simd_arith
+    { enum { __value = __simd_traits<_Tp>::__value }; };
+
+  template<>
+    struct __valarray_simd_arith<signed char>
+    { enum { __value = 0 }; };
+
+  template<>
+    struct __valarray_simd_arith<short>
+    { enum { __value = 0 }; };
+
+#ifndef __CHAR_UNSIGNED__
+  template<>
+    struct __valarray_simd_arith<char>
+    { enum { __value = 0 }; };
+#endif
+
+#define _DEFINE_VALARRAY_SIMD_OP(_Name, _Cond)				\
+  struct _Name;								\
+									\
+  template<typename _Tp>						\
+    struct __valarray_simd_op<_Name, _Tp>				\
+    { enum { __value = _Cond }; };
+
+   _DEFINE_VALARRAY_SIMD_OP(__unary_plus, __valarray_simd_arith<_Tp>::__value)
+   _DEFINE_VALARRAY_SIMD_OP(__negate, __valarray_simd_arith<_Tp>::__value)
+   _DEFINE_VALARRAY_SIMD_OP(__plus, __valarray_simd_arith<_Tp>::__value)
+   _DEFINE_VALARRAY_SIMD_OP(__minus, __valarray_simd_arith<_Tp>::__value)
+   _DEFINE_VALARRAY_SIMD_OP(__multiplies, (__valarray_simd_arith<_Tp>::__value
+					   && (!__simd_traits<_Tp>::__integral
+					       || (sizeof(_Tp)
+						   <= _GLIBCXX_VALARRAY_SIMD_IMUL))))
+   _DEFINE_VALARRAY_SIMD_OP(__divides, (__simd_traits<_Tp>::__value
+					&& !__simd_traits<_Tp>::__integral))
+   _DEFINE_VALARRAY_SIMD_OP(__modulus, 0)
+   _DEFINE_VALARRAY_SIMD_OP(__bitwise_not, __simd_traits<_Tp>::__integral)
+   _DEFINE_VALARRAY_SIMD_OP(__bitwise_xor, __simd_traits<_Tp>::__integral)
+   _DEFINE_VALARRAY_SIMD_OP(__bitwise_or, __simd_traits<_Tp>::__integral)
+   _DEFINE_VALARRAY_SIMD_OP(__bitwise_and, __simd_traits<_Tp>::__integral)
+   _DEFINE_VALARRAY_SIMD_OP(__shift_left, (__simd_traits<_Tp>::__integral
+					   && sizeof(_Tp) >= sizeof(int)))
+   _DEFINE_VALARRAY_SIMD_OP(__shift_right, (__simd_traits<_Tp>::__integral
+					    && sizeof(_Tp) >= sizeof(int)))
+
+#undef _DEFINE_VALARRAY_SIMD_OP
+
+  // Whether the closure _Clos can be evaluated a vector of elements at
+  // a time: true for valarrays of a vectorizable type and for the
+  // arithmetic closures built on them and on constants (see the end of
+  // valarray_before.h).  Such a closure has a member _M_vec<_Vec>(__i)
+  // returning its elements [__i, __i + lanes) as one vector.  Each lane
+  // only depends on the same lane of the operands, so the elements are
+  // exactly those operator[] computes.
+  template<class _Clos>
+    struct __valarray_simd
+    { enum { __value = 0 }; };
+
+  template<typename _Tp>
+    struct __valarray_simd<valarray<_Tp> >
+    { enum { __value = __simd_traits<_Tp>::__value }; };
+
+  template<typename _Vec, typename _Tp>
+    inline _Vec
+    __valarray_vec(const valarray<_Tp>& __v, size_t __i)
+    { return std::__simd_load(&__v[__i]); }
+
+  template<typename _Vec, typename _Tp>
+    inline _Vec
+    __valarray_vec(const _Tp* __p, size_t __i)
+    { return std::__simd_load(__p + __i); }
+
+  template<typename _Vec, class _Clos>
+    inline _Vec
+    __valarray_vec(const _Clos& __c, size_t __i)
+    { return __c.template _M_vec<_Vec>(__i); }
+
+  // The right-hand side of an augmented assignment by a scalar.
+  template<typename _Tp>
+    struct _Array_simd_scalar
+    {
+      explicit _Array_simd_scalar(const _Tp& __t) : _M_t(__t) {}
+
+      const _Tp& operator[](size_t) const { return _M_t; }
+
+      template<typename _Vec>
+        _Vec _M_vec(size_t) const { return std::__simd_splat(_M_t); }
+
+      const _Tp& _M_t;
+    };
+
+  //
+  // Elementwise loops over [__i, __n): a vector of elements at a time,
+  // then one element at a time.  __e is a closure for which
+  // __valarray_simd holds, a pointer to the elements of an array or an
+  // _Array_simd_scalar.
+  //
+  struct _Array_simd_copy
+  {
+    template<class _Src, typename _Tp>
+      static void
+      _S_range(const _Src& __e, size_t __i, size_t __n, _Tp* __p)
+      {
+	typedef typename __simd_traits<_Tp>::__vec _Vec;
+	const size_t __lanes = __simd_traits<_Tp>::__lanes;
+	for (; __n - __i >= __lanes; __i += __lanes)
+	  std::__simd_store(__p + __i, std::__valarray_vec<_Vec>(__e, __i));
+	for (; __i < __n; ++__i)
+	  __p[__i] = __e[__i];
+      }
+  };
+
+  template<class _Oper>
+    struct _Array_simd_augment
+    {
+      template<class _Src, typename _Tp>
+        static void
+        _S_range(const _Src& __e, size_t __i, size_t __n, _Tp* __p)
+        {
+	  typedef typename __simd_traits<_Tp>::__vec _Vec;
+	  const size_t __lanes = __simd_traits<_Tp>::__lanes;
+	  for (; __n - __i >= __lanes; __i += __lanes)
+	    std::__simd_store(__p + __i,
+			      _Oper()(std::__simd_load(__p + __i),
+				      std::__valarray_vec<_Vec>(__e, __i)));
+	  for (; __i < __n; ++__i)
+	    __p[__i] = _Oper()(__p[__i], __e[__i]);
+	}
+    };
+
+#ifdef _GLIBCXX_VALARRAY_PARALLEL
+  // Block __i of an elementwise loop, run on the thread pool.
+  template<class _Kernel, class _Src, typename _Tp>
+    struct _Array_simd_task
+    {
+      const _Src&                                _M_src;
+      _Tp*                                       _M_data;
+      const __gnu_cxx::__parallel_blocks&        _M_blocks;
+
+      _Array_simd_task(const _Src& __e, _Tp* __p,
+		       const __gnu_cxx::__parallel_blocks& __blocks)
+      : _M_src(__e), _M_data(__p), _M_blocks(__blocks) {}
+
+      void
+      operator()(size_t __i)
+      {
+	_Kernel::_S_range(_M_src, _M_blocks._M_begin(__i),
+			  _M_blocks._M_begin(__i + 1), _M_data);
+      }
+    };
+#endif
+
+  // The vector forms of the loops over valarray expressions.  Each
+  // returns false, leaving everything to the scalar loop of its caller,
+  // unless instantiated with true.  With _GLIBCXX_VALARRAY_PARALLEL
+  // defined, assignments of at least two blocks of
+  // _GLIBCXX_PARALLEL_GRAIN elements are also split across the threads
+  // of ext/thread_pool.h.
+  template<bool>
+    struct _Array_simd
+    {
+      template<class _Src, typename _Tp>
+        static bool
+        _S_copy(const _Src&, size_t, _Tp*)
+        { return false; }
+
+      template<class _Oper, class _Src, typename _Tp>
+        static bool
+        _S_augment(const _Src&, size_t, _Tp*)
+        { return false; }
+
+      template<class _Src, typename _Tp>
+        static bool
+        _S_sum(const _Src&, size_t, _Tp&)
+        { return false; }
+
+      template<class _Op, class _Src, typename _Tp>
+        static bool
+        _S_extremum(const _Src&, size_t, _Tp&)
+        { return false; }
+    };
+
+  template<>
+    struct _Array_simd<true>
+    {
+      // __p[i] = __e[i] for i in [0, __n).
+      template<class _Src, typename _Tp>
+        static bool
+        _S_copy(const _Src& __e, size_t __n, _Tp* __p)
+        {
+	  _S_run<_Array_simd_copy>(__e, __n, __p);
+	  return true;
+	}
+
+      // __p[i] = _Oper()(__p[i], __e[i]) for i in [0, __n).
+      template<class _Oper, class _Src, typename _Tp>
+        static bool
+        _S_augment(const _Src& __e, size_t __n, _Tp* __p)
+        {
+	  _S_run<_Array_simd_augment<_Oper> >(__e, __n, __p);
+	  return true;
+	}
+
+      // Adds the sum of __e[0], ..., __e[__n - 1] to __r, in four
+      // vector accumulators.  The additions are reassociated, which
+      // the standard allows: it leaves their order unspecified.
+      template<class _Src, typename _Tp>
+        static bool
+        _S_sum(const _Src& __e, size_t __n, _Tp& __r)
+        {
+	  typedef typename __simd_traits<_Tp>::__vec _Vec;
+	  const size_t __lanes = __simd_traits<_Tp>::__lanes;
+	  size_t __i = 0;
+	  if (__n >= 4 * __lanes)
+	    {
+	      _Vec __a0 = std::__valarray_vec<_Vec>(__e, 0);
+	      _Vec __a1 = std::__valarray_vec<_Vec>(__e, __lanes);
+	      _Vec __a2 = std::__valarray_vec<_Vec>(__e, 2 * __lanes);
+	      _Vec __a3 = std::__valarray_vec<_Vec>(__e, 3 * __lanes);
+	      for (__i = 4 * __lanes; __n - __i >= 4 * __lanes;
+		   __i += 4 * __lanes)
+		{
+		  __a0 += std::__valarray_vec<_Vec>(__e, __i);
+		  __a1 += std::__valarray_vec<_Vec>(__e, __i + __lanes);
+		  __a2 += std::__valarray_vec<_Vec>(__e, __i + 2 * __lanes);
+		  __a3 += std::__valarray_vec<_Vec>(__e, __i + 3 * __lanes);
+		}
+	      __r = std::__simd_reduce_add<_Tp>((__a0 + __a1) + (__a2 + __a3),
+						__r);
+	    }
+	  for (; __i < __n; ++__i)
+	    __r += __e[__i];
+	  return true;
+	}
+
+      // Replaces __r, which holds __e[0], by the smallest (largest) of
+      // __e[0], ..., __e[__n - 1], for _Op __simd_min (__simd_max).
+      // Every lane starts from __e[0] and only takes a value that
+      // compares better, so NaNs are skipped as by the scalar loop.
+      template<class _Op, class _Src, typename _Tp>
+        static bool
+        _S_extremum(const _Src& __e, size_t __n, _Tp& __r)
+        {
+	  typedef typename __simd_traits<_Tp>::__vec _Vec;
+	  const size_t __lanes = __simd_traits<_Tp>::__lanes;
+	  size_t __i = 1;
+	  if (__n >= 2 * __lanes)
+	    {
+	      _Vec __a0 = std::__simd_splat(__r);
+	      _Vec __a1 = __a0;
+	      for (__i = 0; __n - __i >= 2 * __lanes; __i += 2 * __lanes)
+		{
+		  __a0 = _Op::_S_vec(std::__valarray_vec<_Vec>(__e, __i),
+				     __a0);
+		  __a1 = _Op::_S_vec(std::__valarray_vec<_Vec>(__e,
+							       __i + __lanes),
+				     __a1);
+		}
+	      __a0 = _Op::_S_vec(__a1, __a0);
+	      for (size_t __j = 0; __j < __lanes; ++__j)
+		if (_Op::_S_better(__a0[__j], __r))
+		  __r = __a0[__j];
+	    }
+	  for (; __i < __n; ++__i)
+	    {
+	      const _Tp __t = __e[__i];
+	      if (_Op::_S_better(__t, __r))
+		__r = __t;
+	    }
+	  return true;
+	}
+
+    private:
+      template<class _Kernel, class _Src, typename _Tp>
+        static void
+        _S_run(const _Src& __e, size_t __n, _Tp* __p)
+        {
+#ifdef _GLIBCXX_VALARRAY_PARALLEL
+	  if (__n >= 2 * _GLIBCXX_PARALLEL_GRAIN)
+	    {
+	      const __gnu_cxx::__parallel_blocks __blocks(__n);
+	      _Array_simd_task<_Kernel, _Src, _Tp> __task(__e, __p, __blocks);
+	      __gnu_cxx::__thread_pool::_S_instance()._M_run(__task,
+							     __blocks._M_count);
+	      return;
+	    }
+#endif
+	  _Kernel::_S_range(__e, 0, __n, __p);
+	}
+    };
+
   //
   // Compute the sum of elements in range [__f, __l)
   // This is a naive algorithm.  It suffers from cancelling.
@@ -355,6 +712,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_sum(const _Tp* __restrict__ __f, const _Tp* __restrict__ __l)
     {
       _Tp __r = _Tp();
+      if (_Array_simd<__valarray_simd_op<__plus, _Tp>::__value>::
+	  _S_sum(__f, __l - __f, __r))
+	return __r;
       while (__f != __l)
 	__r += *__f++;
       return __r;
@@ -380,6 +740,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       size_t __s = __a.size();
       typedef typename _Ta::value_type _Value_type;
       _Value_type __r = __s == 0 ? _Value_type() : __a[0];
+      if (_Array_simd<__valarray_simd<_Ta>::__value>::
+	  template _S_extremum<__simd_min<_Value_type> >(__a, __s, __r))
+	return __r;
       for (size_t __i = 1; __i < __s; ++__i)
 	{
 	  _Value_type __t = __a[__i];
@@ -396,15 +759,253 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       size_t __s = __a.size();
       typedef typename _Ta::value_type _Value_type;
       _Value_type __r = __s == 0 ? _Value_type() : __a[0];
+      if (_Array_simd<__valarray_simd<_Ta>::__value>::
+	  template _S_extremum<__simd_max<_Value_type> >(__a, __s, __r))
+	return __r;
       for (size_t __i = 1; __i < __s; ++__i)
 	{
 	  _Value_type __t = __a[__i];
-	  if (__t > __r)
+	  if (__r < __t)
 	    __r = __t;
 	}
       return __r;
     }
 
+  // The number of true elements of __m[<__n>], the size of the
+  // mask_array __m selects.
+  inline size_t
+  __valarray_count_true(const bool* __m, size_t __n)
+  {
+#if _GLIBCXX_USE_SIMD
+    if (sizeof(bool) == 1)
+      {
+	const unsigned char* __b = reinterpret_cast<const unsigned char*>(__m);
+	return __n - std::__simd_count(__b, __b + __n, (unsigned char)0);
+      }
+#endif
+    size_t __s = 0;
+    for (size_t __i = 0; __i < __n; ++__i)
+      __s += __m[__i];
+    return __s;
+  }
+
+  // Hands each true element of the mask word __m[<__i, __i + 8>] to
+  // __f, the __k-th true one on, and returns how many there were.  The
+  // word is made a byte of bits first, so that only the end of the
+  // loop over its set bits is hard to predict, not every element.
+  // Kernels that can do better for a whole word overload this.
+  template<class _Fn>
+    inline size_t
+    __valarray_mask_word(_Fn& __f, const bool* __m, size_t __i, size_t __k)
+    {
+      unsigned int __bits = 0;
+      for (int __j = 0; __j < 8; ++__j)
+	__bits |= unsigned(__m[__i + __j]) << __j;
+      const size_t __k0 = __k;
+      for (; __bits; __bits &= __bits - 1)
+	__f(__i + __builtin_ctz(__bits), __k++, 1);
+      return __k - __k0;
+    }
+
+  //
+  // Kernels for __valarray_mask_runs: the __c elements of the masked
+  // array from __i on are the __k-th to (__k + __c - 1)-th selected.
+  //
+  template<typename _Tp>
+    struct _Array_mask_fill
+    {
+      _Tp*       _M_data;
+      const _Tp& _M_t;
+
+      _Array_mask_fill(_Tp* __p, const _Tp& __t)
+      : _M_data(__p), _M_t(__t) {}
+
+      void
+      operator()(size_t __i, size_t, size_t __c) const
+      { std::__valarray_fill(_M_data + __i, __c, _M_t); }
+    };
+
+  // __dst[<__k, __k + __c>] = __src[<__i, __i + __c>]
+  template<typename _Tp>
+    struct _Array_mask_gather
+    {
+      const _Tp* _M_src;
+      _Tp*       _M_dst;
+
+      _Array_mask_gather(const _Tp* __src, _Tp* __dst)
+      : _M_src(__src), _M_dst(__dst) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __c) const
+      {
+	for (size_t __j = 0; __j < __c; ++__j)
+	  _M_dst[__k + __j] = _M_src[__i + __j];
+      }
+    };
+
+  // A word of a mask gathering PODs is compacted without a branch: each
+  // of its elements is stored to the next place of the destination,
+  // which only moves on past the selected ones.  With at least eight
+  // elements still to be selected, the destination has room for eight.
+  template<typename _Tp>
+    inline size_t
+    __valarray_mask_word(_Array_mask_gather<_Tp>& __f, const bool* __m,
+			 size_t __i, size_t __k)
+    {
+      const _Tp* __p = __f._M_src + __i;
+      _Tp* const __q0 = __f._M_dst + __k;
+      _Tp* __q = __q0;
+      if (__is_pod<_Tp>::__value)
+	for (size_t __j = __i; __j < __i + 8; ++__j, ++__p)
+	  {
+	    *__q = *__p;
+	    __q += __m[__j];
+	  }
+      else
+	for (size_t __j = __i; __j < __i + 8; ++__j, ++__p)
+	  if (__m[__j])
+	    *__q++ = *__p;
+      return __q - __q0;
+    }
+
+  // __dst[<__i, __i + __c>] = __src[<__k, __k + __c>]
+  template<typename _Tp>
+    struct _Array_mask_scatter
+    {
+      _Tp*       _M_dst;
+      const _Tp* _M_src;
+
+      _Array_mask_scatter(_Tp* __dst, const _Tp* __src)
+      : _M_dst(__dst), _M_src(__src) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __c) const
+      {
+	for (size_t __j = 0; __j < __c; ++__j)
+	  _M_dst[__i + __j] = _M_src[__k + __j];
+      }
+    };
+
+  template<class _Dom, typename _Tp>
+    struct _Array_mask_scatter_expr
+    {
+      _Tp*                     _M_dst;
+      const _Expr<_Dom, _Tp>&  _M_src;
+
+      _Array_mask_scatter_expr(_Tp* __dst, const _Expr<_Dom, _Tp>& __e)
+      : _M_dst(__dst), _M_src(__e) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __c) const
+      {
+	for (size_t __j = 0; __j < __c; ++__j)
+	  _M_dst[__i + __j] = _M_src[__k + __j];
+      }
+    };
+
+  template<typename _Tp>
+    struct _Array_mask_construct
+    {
+      const _Tp* _M_src;
+      _Tp*       _M_dst;
+
+      _Array_mask_construct(const _Tp* __src, _Tp* __dst)
+      : _M_src(__src), _M_dst(__dst) {}
+
+      void
+      operator()(size_t __i, size_t __k, size_t __c) const
+      {
+	for (size_t __j = 0; __j < __c; ++__j)
+	  new (_M_dst + __k + __j) _Tp(_M_src[__i + __j]);
+      }
+    };
+
+  // Whether __valarray_mask_word handles words of true elements as well
+  // as a run would: then the walk does not look for runs, which in a
+  // dense random mask are as hard to predict as the elements.
+  template<class _Fn>
+    struct __valarray_mask_compacts
+    { enum { __value = 0 }; };
+
+  template<typename _Tp>
+    struct __valarray_mask_compacts<_Array_mask_gather<_Tp> >
+    { enum { __value = __is_pod<_Tp>::__value }; };
+
+  //
+  // Walks the mask __m until __n true elements have been seen, calling
+  // __f(__i, __k, __c) for runs of __c consecutive true elements from
+  // __m[__i] on, the __k-th true one being the first.  Only the
+  // elements up to the __n-th true one are known to exist, so a word
+  // of eight bools is read only while at least eight true elements are
+  // left: words of false elements are skipped, words of true ones
+  // merged into a run, and the others handed to __valarray_mask_word.
+  //
+  template<class _Fn>
+    void
+    __valarray_mask_runs(const bool* __m, size_t __n, _Fn& __f)
+    {
+      typedef unsigned long long _Word;
+      const _Word __ones = _Word(-1) / 0xff;
+      const size_t __w = sizeof(_Word);
+      size_t __i = 0;
+      size_t __k = 0;
+      if (sizeof(bool) == 1)
+	while (__n - __k >= __w)
+	  {
+	    _Word __b;
+	    __builtin_memcpy(&__b, __m + __i, __w);
+	    if (__b == 0)
+	      __i += __w;
+	    else if (!__valarray_mask_compacts<_Fn>::__value && __b == __ones)
+	      {
+		size_t __c = __w;
+		while (__n - __k - __c >= __w)
+		  {
+		    __builtin_memcpy(&__b, __m + __i + __c, __w);
+		    if (__b != __ones)
+		      break;
+		    __c += __w;
+		  }
+		__f(__i, __k, __c);
+		__i += __c;
+		__k += __c;
+	      }
+	    else
+	      {
+		__k += std::__valarray_mask_word(__f, __m, __i, __k);
+		__i += __w;
+	      }
+	  }
+      for (; __k < __n; ++__i)
+	if (__m[__i])
+	  __f(__i, __k++, 1);
+    }
+
+  //
+  // Walks the gslice of start __o, lengths __l[<__d>] and strides
+  // __s[<__d>] a row at a time, without its index array: __row(__i,
+  // __k, __n, __t) is called for the __n elements at __i, __i + __t,
+  // ..., which are elements [__k, __k + __n) of the gslice.  Inner
+  // dimensions that continue one another, as those of a box in a
+  // row-major array do, are merged into longer rows.
+  //
+  template<class _Row>
+    void
+    __valarray_gslice_rows(size_t __o, const size_t* __l, const size_t* __s,
+			   size_t __d, size_t __n, size_t __t, size_t& __k,
+			   _Row& __row)
+    {
+      if (__d == 0)
+	{
+	  __row(__o, __k, __n, __t);
+	  __k += __n;
+	}
+      else
+	for (size_t __j = 0; __j < __l[0]; ++__j, __o += __s[0])
+	  std::__valarray_gslice_rows(__o, __l + 1, __s + 1, __d - 1,
+				      __n, __t, __k, __row);
+    }
+
   //
   // Helper class _Array, first layer of valarray abstraction.
   // All operations on valarray should be forwarded to this class
@@ -534,11 +1135,33 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array<_Tp>::begin () const
     { return _M_data; }
 
+  template<class _Row>
+    inline void
+    __valarray_gslice_rows(size_t __o, _Array<size_t> __l,
+			   _Array<size_t> __s, size_t __d, _Row& __row)
+    {
+      if (__d == 0)
+	return;
+      size_t __n = __l._M_data[--__d];
+      const size_t __t = __s._M_data[__d];
+      while (__d && __s._M_data[__d - 1] == __n * __t)
+	__n *= __l._M_data[--__d];
+      if (__n == 0)
+	return;
+      size_t __k = 0;
+      std::__valarray_gslice_rows(__o, __l._M_data, __s._M_data, __d,
+				  __n, __t, __k, __row);
+    }
+
 #define _DEFINE_ARRAY_FUNCTION(_Op, _Name)				\
   template<typename _Tp>		        			\
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, const _Tp& __t) \
     {									\
+      if (_Array_simd<__valarray_simd_op<_Name, _Tp>::__value>::	\
+	  template _S_augment<_Name>(_Array_simd_scalar<_Tp>(__t),	\
+				     __n, __a._M_data))			\
+	return;								\
       for (_Tp* __p = __a._M_data; __p < __a._M_data + __n; ++__p)	\
         *__p _Op##= __t;						\
     }									\
@@ -547,6 +1170,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, _Array<_Tp> __b) \
     {									\
+      const _Tp* __src = __b._M_data;					\
+      if (_Array_simd<__valarray_simd_op<_Name, _Tp>::__value>::	\
+	  template _S_augment<_Name>(__src, __n, __a._M_data))		\
+	return;								\
       _Tp* __p = __a._M_data;						\
       for (_Tp* __q = __b._M_data; __q < __b._M_data + __n; ++__p, ++__q) \
         *__p _Op##= *__q;						\
@@ -557,6 +1184,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array_augmented_##_Name(_Array<_Tp> __a,	        		\
                              const _Expr<_Dom, _Tp>& __e, size_t __n)	\
     {									\
+      if (_Array_simd<(__valarray_simd_op<_Name, _Tp>::__value		\
+		       && __valarray_simd<_Dom>::__value)>::		\
+	  template _S_augment<_Name>(__e(), __n, __a._M_data))		\
+	return;								\
       _Tp* __p(__a._M_data);						\
       for (size_t __i = 0; __i < __n; ++__i, ++__p)                     \
         *__p _Op##= __e[__i];                                          	\
@@ -567,9 +1198,14 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, size_t __s,	\
 	                     _Array<_Tp> __b)				\
     {									\
+      if (__s == 1)							\
+	{								\
+	  _Array_augmented_##_Name(__a, __n, __b);			\
+	  return;							\
+	}								\
+      _Tp* __p(__a._M_data);						\
       _Tp* __q(__b._M_data);						\
-      for (_Tp* __p = __a._M_data; __p < __a._M_data + __s * __n;       \
-	   __p += __s, ++__q)                                           \
+      for (size_t __i = 0; __i < __n; ++__i, __p += __s, ++__q)		\
         *__p _Op##= *__q;						\
     }									\
 									\
@@ -578,6 +1214,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array_augmented_##_Name(_Array<_Tp> __a, _Array<_Tp> __b,		\
 		             size_t __n, size_t __s)			\
     {									\
+      if (__s == 1)							\
+	{								\
+	  _Array_augmented_##_Name(__a, __n, __b);			\
+	  return;							\
+	}								\
       _Tp* __q(__b._M_data);						\
       for (_Tp* __p = __a._M_data; __p < __a._M_data + __n;             \
 	   ++__p, __q += __s)                                           \
@@ -589,6 +1230,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __s,		\
                              const _Expr<_Dom, _Tp>& __e, size_t __n)	\
     {									\
+      if (__s == 1)							\
+	{								\
+	  _Array_augmented_##_Name(__a, __e, __n);			\
+	  return;							\
+	}								\
       _Tp* __p(__a._M_data);						\
       for (size_t __i = 0; __i < __n; ++__i, __p += __s)                \
         *__p _Op##= __e[__i];                                          	\
@@ -44,17 +44,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_fill(_Array<_Tp> __a, size_t __n, _Array<bool> __m,
 		    const _Tp& __t)
     {
-      _Tp* __p = __a._M_data;
-      bool* __ok (__m._M_data);
-      for (size_t __i=0; __i < __n; ++__i, ++__ok, ++__p)
-	{
-	  while (!*__ok)
-	  {
-	    ++__ok;
-	    ++__p;
-	  }
-	  *__p = __t;
-	}
+      _Array_mask_fill<_Tp> __f(__a._M_data, __t);
+      std::__valarray_mask_runs(__m._M_data, __n, __f);
     }
 
   // Copy n elements of a into consecutive elements of b.  When m is
@@ -68,18 +59,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(_Array<_Tp> __a, _Array<bool> __m, _Array<_Tp> __b,
 		    size_t __n)
     {
-      _Tp* __p (__a._M_data);
-      bool* __ok (__m._M_data);
-      for (_Tp* __q = __b._M_data; __q < __b._M_data + __n;
-	   ++__q, ++__ok, ++__p)
-	{
-	  while (! *__ok)
-	    {
-	      ++__ok;
-	      ++__p;
-	    }
-	  *__q = *__p;
-	}
+      _Array_mask_gather<_Tp> __f(__a._M_data, __b._M_data);
+      std::__valarray_mask_runs(__m._M_data, __n, __f);
     }
 
   // Copy n consecutive elements from a into elements of b.  Elements
@@ -93,18 +74,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(_Array<_Tp> __a, size_t __n, _Array<_Tp> __b,
 		    _Array<bool> __m)
     {
-      _Tp* __q (__b._M_data);
-      bool* __ok (__m._M_data);
-      for (_Tp* __p = __a._M_data; __p < __a._M_data+__n;
-	   ++__p, ++__ok, ++__q)
-	{
-	  while (! *__ok)
-	    {
-	      ++__ok;
-	      ++__q;
-	    }
-	  *__q = *__p;
-	}
+      _Array_mask_scatter<_Tp> __f(__b._M_data, __a._M_data);
+      std::__valarray_mask_runs(__m._M_data, __n, __f);
     }
 
   // Copy n elements from a into elements of b.  Elements of a are
@@ -144,6 +115,9 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     void
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n, _Array<_Tp> __a)
     {
+      if (_Array_simd<__valarray_simd<_Dom>::__value>::_S_copy(__e(), __n,
+								 __a._M_data))
+	return;
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, ++__p)
 	*__p = __e[__i];
@@ -156,6 +130,11 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n,
 		     _Array<_Tp> __a, size_t __s)
     {
+      if (__s == 1)
+	{
+	  std::__valarray_copy(__e, __n, __a);
+	  return;
+	}
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, __p += __s)
 	*__p = __e[__i];
@@ -198,17 +177,8 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n,
 		    _Array<_Tp> __a, _Array<bool> __m)
     {
-      bool* __ok (__m._M_data);
-      _Tp* __p (__a._M_data);
-      for (size_t __i = 0; __i < __n; ++__i, ++__ok, ++__p)
-	{
-	  while (! *__ok)
-	    {
-	      ++__ok;
-	      ++__p;
-	    }
-	  *__p = __e[__i];
-	}
+      _Array_mask_scatter_expr<_Dom, _Tp> __f(__a._M_data, __e);
+      std::__valarray_mask_runs(__m._M_data, __n, __f);
     }
 
 
@@ -217,6 +187,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy_construct(const _Expr<_Dom, _Tp>& __e, size_t __n,
 			      _Array<_Tp> __a)
     {
+      // The vectorizable types are scalars: assignment constructs them.
+      if (_Array_simd<__valarray_simd<_Dom>::__value>::_S_copy(__e(), __n,
+								 __a._M_data))
+	return;
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, ++__p)
 	new (__p) _Tp(__e[__i]);
@@ -228,16 +202,16 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
     __valarray_copy_construct(_Array<_Tp> __a, _Array<bool> __m,
 			      _Array<_Tp> __b, size_t __n)
     {
-      _Tp* __p (__a._M_data);
-      bool* __ok (__m._M_data);
-      for (_Tp* __q = __b._M_data; __q < __b._M_data+__n; ++__q, ++__ok, ++__p)
+      // Assignment constructs PODs.
+      if (__is_pod<_Tp>::__value)
 	{
-	  while (! *__ok)
-	    {
-	      ++__ok;
-	      ++__p;
-	    }
-	  new (__q) _Tp(*__p);
+	  _Array_mask_gather<_Tp> __f(__a._M_data, __b._M_data);
+	  std::__valarray_mask_runs(__m._M_data, __n, __f);
+	}
+      else
+	{
+	  _Array_mask_construct<_Tp> __f(__a._M_data, __b._M_data);
+	  std::__valarray_mask_runs(__m._M_data, __n, __f);
 	}
     }
 
@@ -480,6 +480,10 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       value_type operator[](size_t __i) const
       { return _Oper()(_M_expr[__i]); }
 
+      template<typename _Vec>
+        _Vec _M_vec(size_t __i) const
+        { return _Oper()(std::__valarray_vec<_Vec>(_M_expr, __i)); }
+
       size_t size() const { return _M_expr.size(); }
       
     private:
@@ -526,6 +530,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       value_type operator[](size_t __i) const
       { return _Oper()(_M_expr1[__i], _M_expr2[__i]); }
 
+      template<typename _Vec>
+        _Vec _M_vec(size_t __i) const
+        {
+	  return _Oper()(std::__valarray_vec<_Vec>(_M_expr1, __i),
+			 std::__valarray_vec<_Vec>(_M_expr2, __i));
+	}
+
       size_t size() const { return _M_expr1.size(); }
 
     private:
@@ -547,6 +558,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       value_type operator[](size_t __i) const
       { return _Oper()(_M_expr1[__i], _M_expr2); }
 
+      template<typename _Vec>
+        _Vec _M_vec(size_t __i) const
+        {
+	  return _Oper()(std::__valarray_vec<_Vec>(_M_expr1, __i),
+			 std::__simd_splat(_M_expr2));
+	}
+
       size_t size() const { return _M_expr1.size(); }
 
     private:
@@ -567,6 +585,13 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       value_type operator[](size_t __i) const
       { return _Oper()(_M_expr1, _M_expr2[__i]); }
 
+      template<typename _Vec>
+        _Vec _M_vec(size_t __i) const
+        {
+	  return _Oper()(std::__simd_splat(_M_expr1),
+			 std::__valarray_vec<_Vec>(_M_expr2, __i));
+	}
+
       size_t size() const { return _M_expr2.size(); }
 
     private:
@@ -661,6 +686,48 @@ _GLIBCXX_BEGIN_NAMESPACE(std)
       _BinClos(const _Tp& __t, const valarray<_Tp>& __v) : _Base(__t, __v) {}
     };
 
+  //
+  // Vector evaluation of the closures above, see __valarray_simd in
+  // valarray_array.h.
+  //
+
+  template<template<class, class> class _Meta, class _Dom>
+    struct __valarray_simd_arg
+    { enum { __value = 0 }; };
+
+  template<class _Dom>
+    struct __valarray_simd_arg<_Expr, _Dom>
+    : __valarray_simd<_Dom> {};
+
+  template<typename _Tp>
+    struct __valarray_simd_arg<_ValArray, _Tp>
+    : __valarray_simd<valarray<_Tp> > {};
+
+  template<typename _Tp>
+    struct __valarray_simd_arg<_Constant, _Tp>
+    { enum { __value = __simd_traits<_Tp>::__value }; };
+
+  template<class _Oper, template<class, class> class _Meta, class _Dom>
+    struct __valarray_simd<_UnClos<_Oper, _Meta, _Dom> >
+    {
+      typedef typename _UnClos<_Oper, _Meta, _Dom>::value_type _Tp;
+
+      enum { __value = (__valarray_simd_op<_Oper, _Tp>::__value
+			&& __valarray_simd_arg<_Meta, _Dom>::__value) };
+    };
+
+  template<class _Oper, template<class, class> class _Meta1,
+	   template<class, class> class _Meta2, class _Dom1, class _Dom2>
+    struct __valarray_simd<_BinClos<_Oper, _Meta1, _Meta2, _Dom1, _Dom2> >
+    {
+      typedef typename _BinClos<_Oper, _Meta1, _Meta2,
+				_Dom1, _Dom2>::value_type _Tp;
+
+      enum { __value = (__valarray_simd_op<_Oper, _Tp>::__value
+			&& __valarray_simd_arg<_Meta1, _Dom1>::__value
+			&& __valarray_simd_arg<_Meta2, _Dom2>::__value) };
+    };
+
     //
     // slice_array closure.
     //
@@ -103,6 +103,42 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
 #endif
   }
 
+  // Ordered access to a single word, for the lock-free containers in
+  // ext/.  __load_acquire keeps later memory accesses from being
+  // hoisted above the load; __store_release keeps earlier ones from
+  // being sunk below the store.
+  template<typename _Tp>
+    inline _Tp
+    __load_acquire(const volatile _Tp* __mem)
+    {
+#ifdef __ATOMIC_ACQUIRE
+      return __atomic_load_n(__mem, __ATOMIC_ACQUIRE);
+#else
+      _Tp __val = *__mem;
+      __sync_synchronize();
+      return __val;
+#endif
+    }
+
+  template<typename _Tp>
+    inline void
+    __store_release(volatile _Tp* __mem, _Tp __val)
+    {
+#ifdef __ATOMIC_RELEASE
+      __atomic_store_n(__mem, __val, __ATOMIC_RELEASE);
+#else
+      __sync_synchronize();
+      *__mem = __val;
+#endif
+    }
+
+  // Full-barrier compare-and-swap; returns true if *__mem held __old
+  // and now holds __new.
+  template<typename _Tp>
+    inline bool
+    __compare_and_swap(volatile _Tp* __mem, _Tp __old, _Tp __new)
+    { return __sync_bool_compare_and_swap(__mem, __old, __new); }
+
 _GLIBCXX_END_NAMESPACE
 
 // Even if the CPU doesn't need a memory barrier, we need to ensure
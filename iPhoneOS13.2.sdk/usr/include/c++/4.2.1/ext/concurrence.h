@@ -48,7 +48,10 @@ _GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
   // _S_mutex     multi-threaded code that requires additional support
   //              from gthr.h or abstraction layers in concurrance.h.
   // _S_atomic    multi-threaded code using atomic operations.
-  enum _Lock_policy { _S_single, _S_mutex, _S_atomic }; 
+  // _S_biased    multi-threaded code where each object is mostly used
+  //              by the thread that made it: that thread updates its
+  //              share of the count without locked read-modify-writes.
+  enum _Lock_policy { _S_single, _S_mutex, _S_atomic, _S_biased }; 
 
   // Compile time constant that indicates prefered locking policy in
   // the current configuration.
@@ -0,0 +1,272 @@
+// Fixed-capacity function object wrapper -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/inplace_function_iterate.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+template<typename _Res, typename _Functor _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  struct _Inplace_invoker<_Res(_GLIBCXX_TEMPLATE_ARGS), _Functor>
+  {
+    static _Res
+    _S_invoke(void* __f _GLIBCXX_COMMA _GLIBCXX_PARAMS)
+    {
+      return std::tr1::__callable_functor(*static_cast<_Functor*>(__f))
+        (_GLIBCXX_ARGS);
+    }
+  };
+
+template<typename _Functor _GLIBCXX_COMMA _GLIBCXX_TEMPLATE_PARAMS>
+  struct _Inplace_invoker<void(_GLIBCXX_TEMPLATE_ARGS), _Functor>
+  {
+    static void
+    _S_invoke(void* __f _GLIBCXX_COMMA _GLIBCXX_PARAMS)
+    {
+      std::tr1::__callable_functor(*static_cast<_Functor*>(__f))
+        (_GLIBCXX_ARGS);
+    }
+  };
+
+template<typename _Res, typename _Functor _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  struct _Inplace_invoker<_Res(_GLIBCXX_TEMPLATE_ARGS),
+                          std::tr1::reference_wrapper<_Functor> >
+  {
+    static _Res
+    _S_invoke(void* __f _GLIBCXX_COMMA _GLIBCXX_PARAMS)
+    {
+      return std::tr1::__callable_functor(
+        static_cast<std::tr1::reference_wrapper<_Functor>*>(__f)->get())
+        (_GLIBCXX_ARGS);
+    }
+  };
+
+template<typename _Functor _GLIBCXX_COMMA _GLIBCXX_TEMPLATE_PARAMS>
+  struct _Inplace_invoker<void(_GLIBCXX_TEMPLATE_ARGS),
+                          std::tr1::reference_wrapper<_Functor> >
+  {
+    static void
+    _S_invoke(void* __f _GLIBCXX_COMMA _GLIBCXX_PARAMS)
+    {
+      std::tr1::__callable_functor(
+        static_cast<std::tr1::reference_wrapper<_Functor>*>(__f)->get())
+        (_GLIBCXX_ARGS);
+    }
+  };
+
+template<typename _Res _GLIBCXX_COMMA _GLIBCXX_TEMPLATE_PARAMS,
+         std::size_t _Capacity>
+class inplace_function<_Res(_GLIBCXX_TEMPLATE_ARGS), _Capacity>
+#if _GLIBCXX_NUM_ARGS == 1
+  : public std::unary_function<_T1, _Res>,
+    private _Inplace_function_base<_Capacity>
+#elif _GLIBCXX_NUM_ARGS == 2
+  : public std::binary_function<_T1, _T2, _Res>,
+    private _Inplace_function_base<_Capacity>
+#else
+  : private _Inplace_function_base<_Capacity>
+#endif
+{
+  typedef _Inplace_function_base<_Capacity> _Base;
+
+  typedef _Res (*_Invoker_type)(void* _GLIBCXX_COMMA
+                                _GLIBCXX_TEMPLATE_ARGS);
+
+  struct _Hidden_type
+  {
+    _Hidden_type* _M_bool;
+  };
+
+  typedef _Hidden_type* _Hidden_type::* _Safe_bool;
+
+  struct _Useless {};
+
+ public:
+  typedef _Res result_type;
+
+  /**
+   *  @brief Default construct creates an empty function call wrapper.
+   */
+  inplace_function() : _Base(), _M_invoker(0) { }
+
+  /**
+   *  @brief Creates an empty function call wrapper from a null pointer.
+   */
+  inplace_function(std::tr1::_M_clear_type*) : _Base(), _M_invoker(0) { }
+
+  /**
+   *  @brief Copies the target of @a x, if it has one, into the new
+   *  wrapper's storage.
+   */
+  inplace_function(const inplace_function& __x)
+  : _Base(), _M_invoker(__x._M_invoker)
+  { this->_M_clone(__x); }
+
+  /**
+   *  @brief Builds a wrapper that holds a copy of @a f.
+   *
+   *  Does not compile if @a f does not fit in @a _Capacity bytes.  If
+   *  @a f is a null function pointer or pointer to member, the wrapper
+   *  is empty.  If @a f is @c reference_wrapper<F>, the wrapper calls
+   *  @c f.get() instead of a copy.
+   */
+  template<typename _Functor>
+    inplace_function(_Functor __f,
+                     typename __gnu_cxx::__enable_if<
+                       !std::tr1::is_integral<_Functor>::value,
+                       _Useless>::__type = _Useless())
+    : _Base(), _M_invoker(0)
+    {
+      this->template _S_check<_Functor>();
+      if (__inplace_not_empty(__f))
+        {
+          this->_M_init(__f);
+          _M_invoker = &_Inplace_invoker<_Res(_GLIBCXX_TEMPLATE_ARGS),
+                                         _Functor>::_S_invoke;
+        }
+    }
+
+  /**
+   *  @brief Replaces the target with a copy of the target of @a x.
+   *
+   *  Copies into a temporary and swaps, so *this is unchanged if the
+   *  copy throws.
+   */
+  inplace_function&
+  operator=(const inplace_function& __x)
+  {
+    inplace_function(__x).swap(*this);
+    return *this;
+  }
+
+  /**
+   *  @brief Destroys the target; *this becomes empty.
+   */
+  inplace_function&
+  operator=(std::tr1::_M_clear_type*)
+  {
+    this->_M_clear();
+    _M_invoker = 0;
+    return *this;
+  }
+
+  /**
+   *  @brief Replaces the target with a copy of @a f.
+   */
+  template<typename _Functor>
+    typename __gnu_cxx::__enable_if<
+      !std::tr1::is_integral<_Functor>::value, inplace_function&>::__type
+    operator=(_Functor __f)
+    {
+      inplace_function(__f).swap(*this);
+      return *this;
+    }
+
+  /**
+   *  @brief Exchanges the targets of two wrappers.
+   *
+   *  Each target is moved by copying it into the other storage and
+   *  destroying the original.  If one of those copies throws, one of
+   *  the two wrappers may be left empty.
+   */
+  void
+  swap(inplace_function& __x)
+  {
+    const _Manager_type __manager = this->_M_manager;
+    const _Invoker_type __invoker = _M_invoker;
+    const _Invoker_type __x_invoker = __x._M_invoker;
+    try
+      { this->_M_swap(__x); }
+    catch(...)
+      {
+        // Either wrapper may hold its own target, the other's, or
+        // none: pair each with the invoker of the target it holds.
+        _M_invoker = _S_invoker_for(this->_M_manager, __manager,
+                                    __invoker, __x_invoker);
+        __x._M_invoker = _S_invoker_for(__x._M_manager, __manager,
+                                        __invoker, __x_invoker);
+        __throw_exception_again;
+      }
+    __x._M_invoker = __invoker;
+    _M_invoker = __x_invoker;
+  }
+
+  /**
+   *  @brief Whether the wrapper has a target.
+   */
+  operator _Safe_bool() const
+  {
+    if (this->_M_empty())
+      return 0;
+    else
+      return &_Hidden_type::_M_bool;
+  }
+
+  /**
+   *  @brief Calls the target.
+   *  @throws std::tr1::bad_function_call if the wrapper is empty.
+   */
+  _Res
+  operator()(_GLIBCXX_PARAMS) const
+  {
+    if (this->_M_empty())
+      {
+#if __EXCEPTIONS
+        throw std::tr1::bad_function_call();
+#else
+        std::abort();
+#endif
+      }
+    return _M_invoker(const_cast<void*>(this->_M_storage._M_access())
+                      _GLIBCXX_COMMA _GLIBCXX_ARGS);
+  }
+
+ private:
+  typedef typename _Base::_Manager_type _Manager_type;
+
+  // The invoker for the target managed by __held, given the manager and
+  // invoker *this had and the invoker of the other wrapper.  Targets of
+  // the same type share both manager and invoker.
+  static _Invoker_type
+  _S_invoker_for(_Manager_type __held, _Manager_type __mine,
+                 _Invoker_type __my_invoker, _Invoker_type __other_invoker)
+  {
+    if (!__held)
+      return 0;
+    return __held == __mine ? __my_invoker : __other_invoker;
+  }
+
+  _Invoker_type _M_invoker;
+};
+
+_GLIBCXX_END_NAMESPACE
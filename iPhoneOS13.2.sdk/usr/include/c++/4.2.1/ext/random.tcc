@@ -0,0 +1,359 @@
+// Random number generation extensions -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/random.tcc
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+#if _GLIBCXX_SFMT_SIMD
+  typedef __sfmt_word __sfmt_vec
+    __attribute__((__vector_size__(16)));
+  typedef unsigned long long __sfmt_halves
+    __attribute__((__vector_size__(16)));
+  typedef long long __sfmt_index
+    __attribute__((__vector_size__(16)));
+
+  inline __sfmt_vec
+  __sfmt_load(const __sfmt_word* __p)
+  {
+    __sfmt_vec __v;
+    __builtin_memcpy(&__v, __p, sizeof(__v));
+    return __v;
+  }
+
+  inline void
+  __sfmt_store(__sfmt_word* __p, __sfmt_vec __v)
+  { __builtin_memcpy(__p, &__v, sizeof(__v)); }
+
+  // Shifts of a whole 128-bit element by __n bytes: each 64-bit half is
+  // shifted, and the bits leaving one half are moved into the other.
+  template<int __n>
+    inline __sfmt_vec
+    __sfmt_lshift128(__sfmt_vec __v)
+    {
+      const __sfmt_halves __q = (__sfmt_halves)__v;
+      const __sfmt_halves __out = __q >> (64 - 8 * __n);
+      const __sfmt_halves __zero = { 0, 0 };
+#ifdef __clang__
+      const __sfmt_halves __carry =
+	__builtin_shufflevector(__out, __zero, 2, 0);
+#else
+      const __sfmt_index __idx = { 2, 0 };
+      const __sfmt_halves __carry = __builtin_shuffle(__out, __zero, __idx);
+#endif
+      return (__sfmt_vec)((__q << (8 * __n)) | __carry);
+    }
+
+  template<int __n>
+    inline __sfmt_vec
+    __sfmt_rshift128(__sfmt_vec __v)
+    {
+      const __sfmt_halves __q = (__sfmt_halves)__v;
+      const __sfmt_halves __out = __q << (64 - 8 * __n);
+      const __sfmt_halves __zero = { 0, 0 };
+#ifdef __clang__
+      const __sfmt_halves __carry =
+	__builtin_shufflevector(__out, __zero, 1, 2);
+#else
+      const __sfmt_index __idx = { 1, 2 };
+      const __sfmt_halves __carry = __builtin_shuffle(__out, __zero, __idx);
+#endif
+      return (__sfmt_vec)((__q >> (8 * __n)) | __carry);
+    }
+#else
+  // Shifts of a whole 128-bit element, held as four 32-bit words with
+  // the least significant first, by __n bytes.
+  template<int __n>
+    inline void
+    __sfmt_lshift128(__sfmt_word* __out, const __sfmt_word* __in)
+    {
+      const unsigned long long __th = ((static_cast<unsigned long long>
+					(__in[3]) << 32) | __in[2]);
+      const unsigned long long __tl = ((static_cast<unsigned long long>
+					(__in[1]) << 32) | __in[0]);
+      const unsigned long long __oh = ((__th << (8 * __n))
+				       | (__tl >> (64 - 8 * __n)));
+      const unsigned long long __ol = __tl << (8 * __n);
+      __out[0] = __sfmt_word(__ol);
+      __out[1] = __sfmt_word(__ol >> 32);
+      __out[2] = __sfmt_word(__oh);
+      __out[3] = __sfmt_word(__oh >> 32);
+    }
+
+  template<int __n>
+    inline void
+    __sfmt_rshift128(__sfmt_word* __out, const __sfmt_word* __in)
+    {
+      const unsigned long long __th = ((static_cast<unsigned long long>
+					(__in[3]) << 32) | __in[2]);
+      const unsigned long long __tl = ((static_cast<unsigned long long>
+					(__in[1]) << 32) | __in[0]);
+      const unsigned long long __oh = __th >> (8 * __n);
+      const unsigned long long __ol = ((__tl >> (8 * __n))
+				       | (__th << (64 - 8 * __n)));
+      __out[0] = __sfmt_word(__ol);
+      __out[1] = __sfmt_word(__ol >> 32);
+      __out[2] = __sfmt_word(__oh);
+      __out[3] = __sfmt_word(__oh >> 32);
+    }
+#endif
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    void
+    simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+			       __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+			       __parity1, __parity2, __parity3, __parity4>::
+    seed(unsigned long __value)
+    {
+      _M_state[0] = __sfmt_word(__value);
+      for (int __i = 1; __i < _S_words; ++__i)
+	{
+	  __sfmt_word __x = _M_state[__i - 1];
+	  __x ^= __x >> 30;
+	  _M_state[__i] = __sfmt_word(1812433253UL * __x + __i);
+	}
+      _M_period_certification();
+      _M_pos = _S_results;
+    }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    template<class _Gen>
+      void
+      simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+				 __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+				 __parity1, __parity2, __parity3, __parity4>::
+      seed(_Gen& __gen, std::tr1::false_type)
+      {
+	for (int __i = 0; __i < _S_words; ++__i)
+	  _M_state[__i] = __sfmt_word(__gen());
+	_M_period_certification();
+	_M_pos = _S_results;
+      }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    void
+    simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+			       __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+			       __parity1, __parity2, __parity3, __parity4>::
+    _M_period_certification()
+    {
+      const __sfmt_word __parity[4] = { __parity1, __parity2,
+					__parity3, __parity4 };
+      __sfmt_word __inner = 0;
+      for (int __i = 0; __i < 4; ++__i)
+	__inner ^= _M_state[__i] & __parity[__i];
+      for (int __i = 16; __i > 0; __i >>= 1)
+	__inner ^= __inner >> __i;
+      if (__inner & 1)
+	return;
+
+      for (int __i = 0; __i < 4; ++__i)
+	for (__sfmt_word __work = 1; __work; __work <<= 1)
+	  if (__work & __parity[__i])
+	    {
+	      _M_state[__i] ^= __work;
+	      return;
+	    }
+    }
+
+  // Each new element depends on the two computed just before it, so the
+  // elements are computed one at a time, each in one vector register.
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    void
+    simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+			       __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+			       __parity1, __parity2, __parity3, __parity4>::
+    _M_gen_rand()
+    {
+      __sfmt_word* const __st = _M_state;
+      const int __n = state_size;
+
+#if _GLIBCXX_SFMT_SIMD
+      const __sfmt_vec __mask = { __msk1, __msk2, __msk3, __msk4 };
+      __sfmt_vec __r1 = __sfmt_load(__st + 4 * (__n - 2));
+      __sfmt_vec __r2 = __sfmt_load(__st + 4 * (__n - 1));
+      for (int __i = 0; __i < __n; ++__i)
+	{
+	  const int __j = __i < __n - __pos1 ? __i + __pos1
+					     : __i + __pos1 - __n;
+	  const __sfmt_vec __a = __sfmt_load(__st + 4 * __i);
+	  const __sfmt_vec __b = __sfmt_load(__st + 4 * __j);
+	  const __sfmt_vec __r = (__a ^ __gnu_cxx::__sfmt_lshift128<__sl2>(__a)
+				  ^ ((__b >> __sr1) & __mask)
+				  ^ __gnu_cxx::__sfmt_rshift128<__sr2>(__r1)
+				  ^ (__r2 << __sl1));
+	  __sfmt_store(__st + 4 * __i, __r);
+	  __r1 = __r2;
+	  __r2 = __r;
+	}
+#else
+      const __sfmt_word __mask[4] = { __msk1, __msk2, __msk3, __msk4 };
+      const __sfmt_word* __r1 = __st + 4 * (__n - 2);
+      const __sfmt_word* __r2 = __st + 4 * (__n - 1);
+      for (int __i = 0; __i < __n; ++__i)
+	{
+	  const int __j = __i < __n - __pos1 ? __i + __pos1
+					     : __i + __pos1 - __n;
+	  __sfmt_word* const __a = __st + 4 * __i;
+	  const __sfmt_word* const __b = __st + 4 * __j;
+	  __sfmt_word __x[4], __y[4];
+	  __gnu_cxx::__sfmt_lshift128<__sl2>(__x, __a);
+	  __gnu_cxx::__sfmt_rshift128<__sr2>(__y, __r1);
+	  for (int __k = 0; __k < 4; ++__k)
+	    __a[__k] = (__a[__k] ^ __x[__k] ^ ((__b[__k] >> __sr1) & __mask[__k])
+			^ __y[__k] ^ __sfmt_word(__r2[__k] << __sl1));
+	  __r1 = __r2;
+	  __r2 = __a;
+	}
+#endif
+      _M_pos = 0;
+    }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    template<class _ForwardIterator>
+      void
+      simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+				 __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+				 __parity1, __parity2, __parity3, __parity4>::
+      _M_generate(_ForwardIterator __first, _ForwardIterator __last,
+		  std::forward_iterator_tag)
+      {
+	for (; __first != __last; ++__first)
+	  *__first = (*this)();
+      }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4>
+    template<class _RandomAccessIterator>
+      void
+      simd_fast_mersenne_twister<_UIntType, __m, __pos1, __sl1, __sl2,
+				 __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+				 __parity1, __parity2, __parity3, __parity4>::
+      _M_generate(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		  std::random_access_iterator_tag)
+      {
+	typedef typename std::iterator_traits<_RandomAccessIterator>::
+	  difference_type _Distance;
+
+	_Distance __len = __last - __first;
+	while (__len > 0)
+	  {
+	    if (_M_pos >= _S_results)
+	      _M_gen_rand();
+	    const _Distance __chunk = std::min(__len,
+					       _Distance(_S_results - _M_pos));
+	    for (_Distance __i = 0; __i < __chunk; ++__i)
+	      __first[__i] = _M_result(_M_pos + __i);
+	    _M_pos += __chunk;
+	    __first += __chunk;
+	    __len -= __chunk;
+	  }
+      }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4, typename _CharT, typename _Traits>
+    std::basic_ostream<_CharT, _Traits>&
+    operator<<(std::basic_ostream<_CharT, _Traits>& __os,
+	       const simd_fast_mersenne_twister<_UIntType, __m, __pos1,
+	       __sl1, __sl2, __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+	       __parity1, __parity2, __parity3, __parity4>& __x)
+    {
+      typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
+      typedef typename __ostream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __os.flags();
+      const _CharT __fill = __os.fill();
+      const _CharT __space = __os.widen(' ');
+      __os.flags(__ios_base::dec | __ios_base::fixed | __ios_base::left);
+      __os.fill(__space);
+
+      for (int __i = 0; __i < __x._S_words; ++__i)
+	__os << __x._M_state[__i] << __space;
+      __os << __x._M_pos;
+
+      __os.flags(__flags);
+      __os.fill(__fill);
+      return __os;
+    }
+
+  template<class _UIntType, int __m, int __pos1, int __sl1, int __sl2,
+	   int __sr1, int __sr2, __sfmt_word __msk1, __sfmt_word __msk2,
+	   __sfmt_word __msk3, __sfmt_word __msk4, __sfmt_word __parity1,
+	   __sfmt_word __parity2, __sfmt_word __parity3,
+	   __sfmt_word __parity4, typename _CharT, typename _Traits>
+    std::basic_istream<_CharT, _Traits>&
+    operator>>(std::basic_istream<_CharT, _Traits>& __is,
+	       simd_fast_mersenne_twister<_UIntType, __m, __pos1,
+	       __sl1, __sl2, __sr1, __sr2, __msk1, __msk2, __msk3, __msk4,
+	       __parity1, __parity2, __parity3, __parity4>& __x)
+    {
+      typedef std::basic_istream<_CharT, _Traits>  __istream_type;
+      typedef typename __istream_type::ios_base    __ios_base;
+
+      const typename __ios_base::fmtflags __flags = __is.flags();
+      __is.flags(__ios_base::dec | __ios_base::skipws);
+
+      for (int __i = 0; __i < __x._S_words; ++__i)
+	__is >> __x._M_state[__i];
+      __is >> __x._M_pos;
+
+      __is.flags(__flags);
+      return __is;
+    }
+
+_GLIBCXX_END_NAMESPACE
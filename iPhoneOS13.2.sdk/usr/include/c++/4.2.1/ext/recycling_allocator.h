@@ -0,0 +1,179 @@
+// Allocator that recycles freed blocks -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+
+/** @file ext/recycling_allocator.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _RECYCLING_ALLOCATOR_H
+#define _RECYCLING_ALLOCATOR_H 1
+
+#include <new>
+#include <bits/functexcept.h>
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  using std::size_t;
+  using std::ptrdiff_t;
+
+  /**
+   *  @brief  An allocator that keeps a few freed blocks for reuse.
+   *
+   *  Behaves as new_allocator, except that up to _Spare deallocated
+   *  blocks of one size are kept on a list in the allocator object and
+   *  handed out again by allocate() for the same size.  A container
+   *  that frees and allocates same-sized nodes at a steady rate, such
+   *  as %deque used as a FIFO, then stops calling operator new once it
+   *  has warmed up:
+   *
+   *  @code
+   *    std::queue<_Tp, std::deque<_Tp, recycling_allocator<_Tp> > >
+   *  @endcode
+   *
+   *  Each object has its own list, released by its destructor.  Copies
+   *  start with an empty list and all objects compare equal, since a
+   *  block from any of them can be freed by any other.
+   */
+  template<typename _Tp, size_t _Spare = 4>
+    class recycling_allocator
+    {
+    public:
+      typedef size_t     size_type;
+      typedef ptrdiff_t  difference_type;
+      typedef _Tp*       pointer;
+      typedef const _Tp* const_pointer;
+      typedef _Tp&       reference;
+      typedef const _Tp& const_reference;
+      typedef _Tp        value_type;
+
+      template<typename _Tp1>
+        struct rebind
+        { typedef recycling_allocator<_Tp1, _Spare> other; };
+
+      recycling_allocator() throw()
+      : _M_free(0), _M_count(0), _M_block(0) { }
+
+      recycling_allocator(const recycling_allocator&) throw()
+      : _M_free(0), _M_count(0), _M_block(0) { }
+
+      template<typename _Tp1>
+        recycling_allocator(const recycling_allocator<_Tp1, _Spare>&) throw()
+	: _M_free(0), _M_count(0), _M_block(0) { }
+
+      ~recycling_allocator() throw()
+      {
+	while (_M_free)
+	  {
+	    _Link* __next = _M_free->_M_next;
+	    ::operator delete(_M_free);
+	    _M_free = __next;
+	  }
+      }
+
+      // Keeps its own list: the blocks are not the other object's.
+      recycling_allocator&
+      operator=(const recycling_allocator&) throw()
+      { return *this; }
+
+      pointer
+      address(reference __x) const { return &__x; }
+
+      const_pointer
+      address(const_reference __x) const { return &__x; }
+
+      pointer
+      allocate(size_type __n, const void* = 0)
+      {
+	if (_M_free && __n == _M_block)
+	  {
+	    _Link* __l = _M_free;
+	    _M_free = __l->_M_next;
+	    --_M_count;
+	    return reinterpret_cast<pointer>(__l);
+	  }
+
+	if (__builtin_expect(__n > this->max_size(), false))
+	  std::__throw_bad_alloc();
+
+	return static_cast<_Tp*>(::operator new(__n * sizeof(_Tp)));
+      }
+
+      // __p is not permitted to be a null pointer.  Only blocks that
+      // can hold the list link are kept.
+      void
+      deallocate(pointer __p, size_type __n)
+      {
+	if (_M_count < _Spare
+	    && __n * sizeof(_Tp) >= sizeof(_Link)
+	    && (!_M_free || __n == _M_block))
+	  {
+	    _Link* __l = reinterpret_cast<_Link*>(__p);
+	    __l->_M_next = _M_free;
+	    _M_free = __l;
+	    _M_block = __n;
+	    ++_M_count;
+	  }
+	else
+	  ::operator delete(__p);
+      }
+
+      size_type
+      max_size() const throw() 
+      { return size_t(-1) / sizeof(_Tp); }
+
+      void 
+      construct(pointer __p, const _Tp& __val) 
+      { ::new(__p) _Tp(__val); }
+
+      void 
+      destroy(pointer __p) { __p->~_Tp(); }
+
+    private:
+      struct _Link
+      { _Link* _M_next; };
+
+      _Link*    _M_free;
+      size_type _M_count;
+      size_type _M_block;  // size of the blocks in _M_free
+    };
+
+  template<typename _Tp, size_t _Spare>
+    inline bool
+    operator==(const recycling_allocator<_Tp, _Spare>&,
+	       const recycling_allocator<_Tp, _Spare>&)
+    { return true; }
+  
+  template<typename _Tp, size_t _Spare>
+    inline bool
+    operator!=(const recycling_allocator<_Tp, _Spare>&,
+	       const recycling_allocator<_Tp, _Spare>&)
+    { return false; }
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
@@ -0,0 +1,291 @@
+// Worker threads for the parallel algorithms -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/thread_pool.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H 1
+
+#include <bits/c++config.h>
+#include <cstddef>
+#include <bits/gthr.h>
+#include <exception_defines.h>
+
+#ifdef __GTHREAD_HAS_COND
+# include <unistd.h>
+#endif
+
+// Upper bound on the number of worker threads, whatever the number of
+// processors.
+#ifndef _GLIBCXX_THREAD_POOL_MAX
+# define _GLIBCXX_THREAD_POOL_MAX 64
+#endif
+
+// Smallest number of elements worth handing to a thread of its own.
+#ifndef _GLIBCXX_PARALLEL_GRAIN
+# define _GLIBCXX_PARALLEL_GRAIN 32768
+#endif
+
+_GLIBCXX_BEGIN_NAMESPACE(__gnu_cxx)
+
+  /**
+   *  @if maint
+   *  The worker threads shared by the parallel algorithms.  _M_run(task,
+   *  n) calls task(i) once for each i in [0, n) and returns when all the
+   *  calls have; the calling thread takes tasks too.  One batch runs at
+   *  a time: a call made while the pool is busy, including one from
+   *  inside a task, runs its tasks in the calling thread.
+   *
+   *  The workers are started on first use, one per additional online
+   *  processor, and live until the program exits.  Without thread
+   *  support, or in a program not linked with the thread library, every
+   *  batch runs in the calling thread.  A task run by a worker must not
+   *  throw: the exception would terminate the program.
+   *  @endif
+   */
+  class __thread_pool
+  {
+  public:
+    typedef void (*_Task_fn)(void*, std::size_t);
+
+    // The pool shared by the whole program.
+    static __thread_pool&
+    _S_instance()
+    {
+      static __thread_pool* __pool = new __thread_pool;
+      return *__pool;
+    }
+
+    // Number of threads a batch can run on, the caller included.
+    std::size_t
+    _M_size() const
+    { return _M_workers + 1; }
+
+    template<typename _Task>
+      void
+      _M_run(_Task& __task, std::size_t __n)
+      { _M_run_tasks(&_S_invoke<_Task>, &__task, __n); }
+
+  private:
+    std::size_t _M_workers;
+
+#ifdef __GTHREAD_HAS_COND
+    __gthread_mutex_t    _M_batch_mutex;   // held while a batch runs
+    __gthread_mutex_t    _M_mutex;         // guards the fields below
+    __gthread_cond_t     _M_work_cond;     // a batch was opened
+    __gthread_cond_t     _M_idle_cond;     // _M_active dropped to zero
+
+    _Task_fn             _M_fn;
+    void*                _M_arg;
+    std::size_t          _M_count;
+    volatile std::size_t _M_next;          // next task to claim
+    unsigned long        _M_generation;    // bumped per batch
+    bool                 _M_open;          // workers may join the batch
+    std::size_t          _M_active;        // workers inside the batch
+#endif
+
+    __thread_pool(const __thread_pool&);
+    __thread_pool& operator=(const __thread_pool&);
+
+    template<typename _Task>
+      static void
+      _S_invoke(void* __task, std::size_t __i)
+      { (*static_cast<_Task*>(__task))(__i); }
+
+#ifdef __GTHREAD_HAS_COND
+    __thread_pool()
+    : _M_workers(0), _M_fn(0), _M_arg(0), _M_count(0), _M_next(0),
+      _M_generation(0), _M_open(false), _M_active(0)
+    {
+      __gthread_mutex_t __mutex_init = __GTHREAD_MUTEX_INIT;
+      __gthread_cond_t __cond_init = __GTHREAD_COND_INIT;
+      _M_batch_mutex = __mutex_init;
+      _M_mutex = __mutex_init;
+      _M_work_cond = __cond_init;
+      _M_idle_cond = __cond_init;
+
+      if (!__gthread_active_p())
+	return;
+
+      long __cpus = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+      __cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+      std::size_t __wanted = __cpus > 1 ? std::size_t(__cpus - 1) : 0;
+      if (__wanted > _GLIBCXX_THREAD_POOL_MAX - 1)
+	__wanted = _GLIBCXX_THREAD_POOL_MAX - 1;
+
+      for (std::size_t __i = 0; __i < __wanted; ++__i)
+	{
+	  __gthread_t __id;
+	  if (__gthread_create(&__id, &_S_worker, this) != 0)
+	    break;
+	  __gthread_detach(__id);
+	  ++_M_workers;
+	}
+    }
+
+    static void*
+    _S_worker(void* __p)
+    {
+      static_cast<__thread_pool*>(__p)->_M_work();
+      return 0;
+    }
+
+    void
+    _M_work()
+    {
+      __gthread_mutex_lock(&_M_mutex);
+      unsigned long __seen = _M_generation;
+      for (;;)
+	{
+	  while (!_M_open || _M_generation == __seen)
+	    __gthread_cond_wait(&_M_work_cond, &_M_mutex);
+	  __seen = _M_generation;
+	  ++_M_active;
+	  const _Task_fn __fn = _M_fn;
+	  void* const __arg = _M_arg;
+	  const std::size_t __count = _M_count;
+	  __gthread_mutex_unlock(&_M_mutex);
+
+	  _M_drain(__fn, __arg, __count);
+
+	  __gthread_mutex_lock(&_M_mutex);
+	  if (--_M_active == 0)
+	    __gthread_cond_broadcast(&_M_idle_cond);
+	}
+    }
+
+    // Claims and runs tasks until none are left.
+    void
+    _M_drain(_Task_fn __fn, void* __arg, std::size_t __count)
+    {
+      for (;;)
+	{
+	  const std::size_t __i = __sync_fetch_and_add(&_M_next, 1);
+	  if (__i >= __count)
+	    break;
+	  __fn(__arg, __i);
+	}
+    }
+
+    // Closes the batch and waits for the workers that joined it.
+    void
+    _M_close()
+    {
+      __gthread_mutex_lock(&_M_mutex);
+      _M_open = false;
+      while (_M_active != 0)
+	__gthread_cond_wait(&_M_idle_cond, &_M_mutex);
+      __gthread_mutex_unlock(&_M_mutex);
+      __gthread_mutex_unlock(&_M_batch_mutex);
+    }
+
+    void
+    _M_run_tasks(_Task_fn __fn, void* __arg, std::size_t __n)
+    {
+      if (_M_workers == 0 || __n < 2
+	  || __gthread_mutex_trylock(&_M_batch_mutex) != 0)
+	{
+	  for (std::size_t __i = 0; __i < __n; ++__i)
+	    __fn(__arg, __i);
+	  return;
+	}
+
+      __gthread_mutex_lock(&_M_mutex);
+      _M_fn = __fn;
+      _M_arg = __arg;
+      _M_count = __n;
+      _M_next = 0;
+      _M_open = true;
+      ++_M_generation;
+      __gthread_cond_broadcast(&_M_work_cond);
+      __gthread_mutex_unlock(&_M_mutex);
+
+      try
+	{ _M_drain(__fn, __arg, __n); }
+      catch(...)
+	{
+	  // Leave nothing for the workers to pick up, then wait for
+	  // them to finish the tasks they hold.
+	  __sync_fetch_and_add(&_M_next, __n);
+	  _M_close();
+	  __throw_exception_again;
+	}
+      _M_close();
+    }
+#else
+    __thread_pool()
+    : _M_workers(0) { }
+
+    void
+    _M_run_tasks(_Task_fn __fn, void* __arg, std::size_t __n)
+    {
+      for (std::size_t __i = 0; __i < __n; ++__i)
+	__fn(__arg, __i);
+    }
+#endif
+  };
+
+  /**
+   *  @if maint
+   *  Splits n elements into _M_count nearly equal blocks, one per
+   *  thread of the pool but none smaller than _GLIBCXX_PARALLEL_GRAIN.
+   *  @endif
+   */
+  struct __parallel_blocks
+  {
+    std::size_t _M_n;
+    std::size_t _M_count;
+
+    explicit
+    __parallel_blocks(std::size_t __n)
+    : _M_n(__n), _M_count(__thread_pool::_S_instance()._M_size())
+    {
+      if (_M_count > __n / _GLIBCXX_PARALLEL_GRAIN)
+	_M_count = __n / _GLIBCXX_PARALLEL_GRAIN;
+      if (_M_count == 0)
+	_M_count = 1;
+    }
+
+    // Offset of the first element of block __i; _M_begin(_M_count) is n.
+    std::size_t
+    _M_begin(std::size_t __i) const
+    {
+      const std::size_t __rem = _M_n % _M_count;
+      return _M_n / _M_count * __i + (__i < __rem ? __i : __rem);
+    }
+  };
+
+_GLIBCXX_END_NAMESPACE
+
+#endif
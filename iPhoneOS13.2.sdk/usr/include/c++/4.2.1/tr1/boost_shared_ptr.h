@@ -82,6 +82,7 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
   using __gnu_cxx::_S_single;
   using __gnu_cxx::_S_mutex;
   using __gnu_cxx::_S_atomic;
+  using __gnu_cxx::_S_biased;
 
   template<typename _Tp>
     struct _Sp_deleter
@@ -105,8 +106,154 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
     { };
 
   template<_Lock_policy _Lp = __default_lock_policy>
+    class _Sp_counted_base;
+
+  /**
+   *  @if maint
+   *  A thread that owns control blocks with the _S_biased policy.  A
+   *  thread gets one when it first makes such a block, and is the
+   *  block's owner from then on: it keeps its share of the count in
+   *  _Sp_bias_base::_M_biased, without read-modify-write operations,
+   *  while other threads use _M_use_count.  The owner's copies need no
+   *  barrier; its releases need one full barrier, so that a thread
+   *  releasing the last reference at the same time cannot be missed.
+   *
+   *  A thread that takes _M_use_count below zero has released a
+   *  reference the owner counted.  If that was the last reference, it
+   *  merges the two counts and disposes of the object itself.
+   *  Otherwise it pushes the block on _M_pending, and the owner merges
+   *  the counts the next time it releases a reference, or when it
+   *  exits.  After the owner has exited, the pushing thread merges
+   *  them itself.
+   *
+   *  Kept alive by its thread and by each block that names it.
+   *  @endif
+   */
+  struct _Sp_bias_owner
+  {
+    typedef _Sp_counted_base<_S_biased> _Block;
+
+    _Block* volatile _M_pending;
+    _Atomic_word     _M_refs;
+
+    // The calling thread's owner, made on first use; 0 if the thread
+    // cannot have one.
+    static _Sp_bias_owner*
+    _S_current();
+
+    // The calling thread's owner if it has one, else 0.
+    static _Sp_bias_owner*
+    _S_peek();
+
+    // Marks the list of an owner whose thread has exited.
+    static _Block*
+    _S_closed();
+
+    void
+    _M_ref()
+    { __gnu_cxx::__atomic_add_dispatch(&_M_refs, 1); }
+
+    void
+    _M_unref()
+    {
+      if (__gnu_cxx::__exchange_and_add_dispatch(&_M_refs, -1) == 1)
+	delete this;
+    }
+
+    // Queues __b, on which the caller holds a weak reference for the
+    // owner to drop.  Returns false if the owner has exited.
+    bool
+    _M_push(_Block* __b);
+
+    // Merges the counts of the queued blocks.  Owner only.
+    void
+    _M_drain();
+
+  private:
+    // The one owner used while the program has a single thread.
+    static _Sp_bias_owner*
+    _S_process();
+
+    static void
+    _S_drain_list(_Block* __b);
+
+#ifdef __GTHREADS
+    static __gthread_key_t&
+    _S_key()
+    {
+      static __gthread_key_t __key;
+      return __key;
+    }
+
+    static bool&
+    _S_key_valid()
+    {
+      static bool __valid;
+      return __valid;
+    }
+
+#ifdef _GLIBCXX_HAVE_TLS
+    static _Sp_bias_owner*&
+    _S_cached()
+    {
+      static __thread _Sp_bias_owner* __owner;
+      return __owner;
+    }
+#endif
+
+    static void
+    _S_make_key()
+    { _S_key_valid() = __gthread_key_create(&_S_key(), _S_exit) == 0; }
+
+    // Runs at thread exit.
+    static void
+    _S_exit(void* __p);
+#endif
+  };
+
+  // Empty helper class except when the template argument is _S_biased.
+  template<_Lock_policy _Lp>
+    class _Sp_bias_base
+    { };
+
+  template<>
+    class _Sp_bias_base<_S_biased>
+    {
+    public:
+      // Low bits of _M_use_count; the count is kept above them.
+      enum
+      {
+	_S_merged = 1, // _M_biased has been added in
+	_S_queued = 2, // pushed for the owner to merge
+	_S_shift = 2,
+	_S_one = 1 << _S_shift
+      };
+
+    protected:
+      _Sp_bias_base()
+      : _M_biased(1), _M_next(0)
+      {
+	_M_owner = _Sp_bias_owner::_S_current();
+	if (_M_owner)
+	  _M_owner->_M_ref();
+      }
+
+      ~_Sp_bias_base()
+      {
+	if (_M_owner)
+	  _M_owner->_M_unref();
+      }
+
+      _Sp_bias_owner*              _M_owner;   // fixed for the lifetime
+      int                          _M_biased;  // owner's share, no atomics
+      _Sp_counted_base<_S_biased>* _M_next;    // in _M_owner->_M_pending
+
+      friend struct _Sp_bias_owner;
+    };
+
+  template<_Lock_policy _Lp>
     class _Sp_counted_base
-    : public _Mutex_base<_Lp>
+    : public _Mutex_base<_Lp>, public _Sp_bias_base<_Lp>
     {
     public:  
       _Sp_counted_base()
@@ -141,17 +288,27 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
       {
 	if (__gnu_cxx::__exchange_and_add_dispatch(&_M_use_count,
 						   -1) == 1)
-	  {
-	    _M_dispose();
+	  _M_release_last();
+      }
+
+      // Called when the last shared reference goes away.
+      void
+      _M_release_last() // nothrow
+      {
+	_M_dispose();
 #ifdef __GTHREADS
-	    _GLIBCXX_READ_MEM_BARRIER;
-	    _GLIBCXX_WRITE_MEM_BARRIER;
+	_GLIBCXX_READ_MEM_BARRIER;
+	_GLIBCXX_WRITE_MEM_BARRIER;
 #endif
-	    if (__gnu_cxx::__exchange_and_add_dispatch(&_M_weak_count,
-						       -1) == 1)
-	      _M_destroy();
-	  }
+	if (__gnu_cxx::__exchange_and_add_dispatch(&_M_weak_count,
+						   -1) == 1)
+	  _M_destroy();
       }
+
+      // _S_biased only: adds _M_biased into _M_use_count.  Called by
+      // the owner, or by anyone once the owner has exited.
+      void
+      _M_merge(); // nothrow
   
       void
       _M_weak_add_ref() // nothrow
@@ -182,18 +339,52 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
       _Atomic_word  _M_weak_count;    // #weak + (#shared != 0)
     };
 
+  // _S_single objects are never shared between threads, so plain
+  // arithmetic is enough even when the program has several.
+  template<>
+    inline void
+    _Sp_counted_base<_S_single>::
+    _M_add_ref_copy()
+    { ++_M_use_count; }
+
   template<>
     inline void
     _Sp_counted_base<_S_single>::
     _M_add_ref_lock()
     {
-      if (__gnu_cxx::__exchange_and_add_dispatch(&_M_use_count, 1) == 0)
+      if (_M_use_count == 0)
+	__throw_bad_weak_ptr();
+      ++_M_use_count;
+    }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_single>::
+    _M_release() // nothrow
+    {
+      if (--_M_use_count == 0)
 	{
-	  _M_use_count = 0;
-	  __throw_bad_weak_ptr();
+	  _M_dispose();
+	  if (--_M_weak_count == 0)
+	    _M_destroy();
 	}
     }
 
+  template<>
+    inline void
+    _Sp_counted_base<_S_single>::
+    _M_weak_add_ref() // nothrow
+    { ++_M_weak_count; }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_single>::
+    _M_weak_release() // nothrow
+    {
+      if (--_M_weak_count == 0)
+	_M_destroy();
+    }
+
 #ifdef __GTHREADS
   template<>
     inline void
@@ -229,6 +420,311 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 					   __count + 1));
     }
 
+  // With _S_biased, _M_use_count holds the references taken by
+  // threads other than the owner, shifted up by _S_shift; it goes
+  // negative when they release some the owner took.  Until the merge,
+  // the object is alive: _M_biased is at least one.
+  template<>
+    inline
+    _Sp_counted_base<_S_biased>::
+    _Sp_counted_base()
+    : _M_use_count(this->_M_owner ? 0 : _S_one | _S_merged),
+      _M_weak_count(1)
+    {
+      if (!this->_M_owner)
+	this->_M_biased = 0;
+    }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_biased>::
+    _M_add_ref_copy()
+    {
+      if (!(__gnu_cxx::__load_acquire(&_M_use_count) & _S_merged)
+	  && this->_M_owner == _Sp_bias_owner::_S_peek())
+	__gnu_cxx::__store_release(&this->_M_biased, this->_M_biased + 1);
+      else
+	__gnu_cxx::__atomic_add_dispatch(&_M_use_count, _S_one);
+    }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_biased>::
+    _M_add_ref_lock()
+    {
+      // Even the owner goes through the CAS here, so that a release
+      // that finds the merged count at zero cannot miss the new
+      // reference.
+      _Atomic_word __count;
+      do
+	{
+	  __count = __gnu_cxx::__load_acquire(&_M_use_count);
+	  long __total = __count >> _S_shift;
+	  if (!(__count & _S_merged))
+	    __total += __gnu_cxx::__load_acquire(&this->_M_biased);
+	  if (__total == 0)
+	    __throw_bad_weak_ptr();
+	}
+      while (!__sync_bool_compare_and_swap(&_M_use_count, __count,
+					   __count + _S_one));
+    }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_biased>::
+    _M_merge() // nothrow
+    {
+      // Once _S_merged is set, _M_biased is no longer read.
+      const _Atomic_word __biased
+	= __gnu_cxx::__load_acquire(&this->_M_biased) << _S_shift;
+      _Atomic_word __old;
+      _Atomic_word __new;
+      do
+	{
+	  __old = __gnu_cxx::__load_acquire(&_M_use_count);
+	  if (__old & _S_merged)
+	    return;
+	  __new = (__old + __biased) | _S_merged;
+	}
+      while (!__sync_bool_compare_and_swap(&_M_use_count, __old, __new));
+
+      if ((__new >> _S_shift) == 0)
+	_M_release_last();
+    }
+
+  template<>
+    inline void
+    _Sp_counted_base<_S_biased>::
+    _M_release() // nothrow
+    {
+      _Sp_bias_owner* const __owner = this->_M_owner;
+      const _Atomic_word __count = __gnu_cxx::__load_acquire(&_M_use_count);
+      if (!(__count & _S_merged)
+	  && __owner == _Sp_bias_owner::_S_peek())
+	{
+	  const int __biased = this->_M_biased - 1;
+	  __gnu_cxx::__store_release(&this->_M_biased, __biased);
+	  if (__biased == 0)
+	    _M_merge();
+#ifdef __GTHREADS
+	  // Pairs with the re-check after _M_push: either this load sees
+	  // the push, or that thread sees the store above.
+	  if (__gthread_active_p())
+	    __sync_synchronize();
+#endif
+	  if (__gnu_cxx::__load_acquire(&__owner->_M_pending))
+	    __owner->_M_drain();
+	  return;
+	}
+
+      if (__count & _S_merged)
+	{
+	  // From here on, an ordinary atomic count.
+	  if ((__gnu_cxx::__exchange_and_add_dispatch(&_M_use_count, -_S_one)
+	       >> _S_shift) == 1)
+	    _M_release_last();
+	  return;
+	}
+
+      // The block is held by a weak reference while it is queued.
+      bool __held = false;
+      _Atomic_word __old;
+      _Atomic_word __new;
+      do
+	{
+	  __old = __gnu_cxx::__load_acquire(&_M_use_count);
+	  __new = __old - _S_one;
+	  if (__new < 0 && !(__old & (_S_merged | _S_queued)))
+	    {
+	      if (!__held)
+		{
+		  _M_weak_add_ref();
+		  __held = true;
+		}
+	      __new |= _S_queued;
+	    }
+	}
+      while (!__sync_bool_compare_and_swap(&_M_use_count, __old, __new));
+
+      if (!(__new & _S_merged)
+	  && (__new >> _S_shift)
+	     + __gnu_cxx::__load_acquire(&this->_M_biased) == 0)
+	{
+	  // That was the last reference: the owner holds none and will
+	  // not take one (see _M_add_ref_lock), so merge here rather
+	  // than leave the object to the owner's next release.
+	  _M_merge();
+	}
+      else if ((__new & _S_queued) && !(__old & _S_queued))
+	{
+	  // This released a reference the owner took; the owner merges.
+	  // The owner may have dropped its last reference since
+	  // _M_biased was read, and drained before the push landed, so
+	  // look again.  The extra weak reference keeps the block alive
+	  // if the owner drains it meanwhile.
+	  _M_weak_add_ref();
+	  if (__owner->_M_push(this))
+	    {
+	      const _Atomic_word __count
+		= __gnu_cxx::__load_acquire(&_M_use_count);
+	      if (!(__count & _S_merged)
+		  && (__count >> _S_shift)
+		     + __gnu_cxx::__load_acquire(&this->_M_biased) == 0)
+		_M_merge();
+	      _M_weak_release();
+	      return;
+	    }
+	  _M_weak_release();
+#ifdef __GTHREADS
+	  _GLIBCXX_READ_MEM_BARRIER;
+#endif
+	  _M_merge();
+	}
+      else if ((__new & _S_merged) && (__new >> _S_shift) == 0)
+	_M_release_last();
+
+      if (__held)
+	_M_weak_release();
+    }
+
+  template<>
+    inline long
+    _Sp_counted_base<_S_biased>::
+    _M_get_use_count() const // nothrow
+    {
+      const _Atomic_word __count = __gnu_cxx::__load_acquire(&_M_use_count);
+      return (__count >> _S_shift)
+	     + (__count & _S_merged
+		? 0 : __gnu_cxx::__load_acquire(&this->_M_biased));
+    }
+
+  inline _Sp_bias_owner::_Block*
+  _Sp_bias_owner::
+  _S_closed()
+  { return reinterpret_cast<_Block*>(_Block::_S_merged); }
+
+  inline _Sp_bias_owner*
+  _Sp_bias_owner::
+  _S_process()
+  {
+    static _Sp_bias_owner __owner = { 0, 1 };
+    return &__owner;
+  }
+
+  inline _Sp_bias_owner*
+  _Sp_bias_owner::
+  _S_peek()
+  {
+#ifdef __GTHREADS
+    if (__gthread_active_p())
+      {
+#ifdef _GLIBCXX_HAVE_TLS
+	return _S_cached();
+#else
+	if (!_S_key_valid())
+	  return 0;
+	return static_cast<_Sp_bias_owner*>(__gthread_getspecific(_S_key()));
+#endif
+      }
+#endif
+    return _S_process();
+  }
+
+  inline _Sp_bias_owner*
+  _Sp_bias_owner::
+  _S_current()
+  {
+#ifdef __GTHREADS
+    if (__gthread_active_p())
+      {
+	if (_Sp_bias_owner* __owner = _S_peek())
+	  return __owner;
+
+	// On some platforms, __gthread_once_t is an aggregate.
+	static __gthread_once_t __once = __GTHREAD_ONCE_INIT;
+	__gthread_once(&__once, _S_make_key);
+	if (!_S_key_valid())
+	  return 0;
+
+	_Sp_bias_owner* __owner = new (std::nothrow) _Sp_bias_owner;
+	if (!__owner)
+	  return 0;
+	__owner->_M_pending = 0;
+	__owner->_M_refs = 1;
+	if (__gthread_setspecific(_S_key(), __owner) != 0)
+	  {
+	    delete __owner;
+	    return 0;
+	  }
+#ifdef _GLIBCXX_HAVE_TLS
+	_S_cached() = __owner;
+#endif
+	return __owner;
+      }
+#endif
+    return _S_process();
+  }
+
+  inline bool
+  _Sp_bias_owner::
+  _M_push(_Block* __b)
+  {
+    _Block* __head;
+    do
+      {
+	__head = __gnu_cxx::__load_acquire(&_M_pending);
+	if (__head == _S_closed())
+	  return false;
+	__b->_M_next = __head;
+      }
+    while (!__sync_bool_compare_and_swap(&_M_pending, __head, __b));
+    return true;
+  }
+
+  inline void
+  _Sp_bias_owner::
+  _M_drain()
+  {
+    _Block* __head;
+    do
+      __head = __gnu_cxx::__load_acquire(&_M_pending);
+    while (!__sync_bool_compare_and_swap(&_M_pending, __head,
+					 static_cast<_Block*>(0)));
+    _S_drain_list(__head);
+  }
+
+  inline void
+  _Sp_bias_owner::
+  _S_drain_list(_Block* __b)
+  {
+    while (__b)
+      {
+	_Block* __next = __b->_M_next;
+	__b->_M_merge();
+	__b->_M_weak_release();
+	__b = __next;
+      }
+  }
+
+#ifdef __GTHREADS
+  inline void
+  _Sp_bias_owner::
+  _S_exit(void* __p)
+  {
+    _Sp_bias_owner* __owner = static_cast<_Sp_bias_owner*>(__p);
+#ifdef _GLIBCXX_HAVE_TLS
+    _S_cached() = 0;
+#endif
+    _Block* __head;
+    do
+      __head = __gnu_cxx::__load_acquire(&__owner->_M_pending);
+    while (!__sync_bool_compare_and_swap(&__owner->_M_pending, __head,
+					 _S_closed()));
+    _S_drain_list(__head);
+    __owner->_M_unref();
+  }
+#endif
+
   template<typename _Ptr, typename _Deleter, _Lock_policy _Lp>
     class _Sp_counted_base_impl
     : public _Sp_counted_base<_Lp>
@@ -257,6 +753,78 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
       _Deleter  _M_del;  // copy constructor must not throw
     };
 
+  // Tag for the constructors that adopt a control block made by
+  // allocate_shared.
+  struct _Sp_make_shared_tag { };
+
+  /**
+   *  @if maint
+   *  Control block made by allocate_shared: one allocation from _Alloc
+   *  holds the counts and the managed object, which the caller
+   *  constructs in place after _S_create.  The object is destroyed when
+   *  the last shared owner releases it, and the storage is returned to
+   *  _Alloc when the last weak owner does.
+   *  @endif
+   */
+  template<typename _Tp, typename _Alloc, _Lock_policy _Lp>
+    class _Sp_counted_inplace
+    : public _Sp_counted_base<_Lp>, private _Alloc
+    {
+      typedef typename _Alloc::template
+        rebind<_Sp_counted_inplace>::other _Block_alloc;
+
+    public:
+      // Allocates a block; its object is not constructed yet.
+      static _Sp_counted_inplace*
+      _S_create(const _Alloc& __a)
+      {
+	_Block_alloc __ba(__a);
+	_Sp_counted_inplace* __p = __ba.allocate(1);
+	::new(static_cast<void*>(__p)) _Sp_counted_inplace(__a);
+	return __p;
+      }
+
+      // Frees a block whose object is not constructed.
+      static void
+      _S_discard(_Sp_counted_inplace* __p) // nothrow
+      {
+	_Block_alloc __ba(static_cast<_Alloc&>(*__p));
+	__p->~_Sp_counted_inplace();
+	__ba.deallocate(__p, 1);
+      }
+
+      void*
+      _M_storage()
+      { return &_M_data; }
+
+      _Tp*
+      _M_get_ptr()
+      { return static_cast<_Tp*>(_M_storage()); }
+
+      virtual void
+      _M_dispose() // nothrow
+      { _M_get_ptr()->~_Tp(); }
+
+      virtual void
+      _M_destroy() // nothrow
+      { _S_discard(this); }
+
+      virtual void*
+      _M_get_deleter(const std::type_info&)
+      { return 0; }
+
+    private:
+      explicit
+      _Sp_counted_inplace(const _Alloc& __a)
+      : _Alloc(__a) { }
+
+      _Sp_counted_inplace(const _Sp_counted_inplace&);
+      _Sp_counted_inplace& operator=(const _Sp_counted_inplace&);
+
+      typename aligned_storage<sizeof(_Tp),
+			       alignment_of<_Tp>::value>::type _M_data;
+    };
+
   template<_Lock_policy _Lp = __default_lock_policy>
     class __weak_count;
 
@@ -282,6 +850,13 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	    }
 	}
 
+      // Adopts the reference held by a block from allocate_shared.
+      template<typename _Tp, typename _Alloc>
+        __shared_count(_Sp_counted_inplace<_Tp, _Alloc, _Lp>* __p,
+		       _Sp_make_shared_tag)
+	: _M_pi(__p) // nothrow
+        { }
+
       // Special case for auto_ptr<_Tp> to provide the strong guarantee.
       template<typename _Tp>
         explicit
@@ -548,6 +1123,16 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	  __enable_shared_from_this_helper(_M_refcount, __p, __p);
 	}
       
+      /** @brief  Construct a %__shared_ptr that owns the object made in
+       *          the control block @a __p by allocate_shared.
+       *  @post   use_count() == 1
+       */
+      template<typename _Alloc>
+        __shared_ptr(_Sp_counted_inplace<_Tp, _Alloc, _Lp>* __p,
+		     _Sp_make_shared_tag)
+	: _M_ptr(__p->_M_get_ptr()), _M_refcount(__p, _Sp_make_shared_tag())
+        { __enable_shared_from_this_helper(_M_refcount, _M_ptr, _M_ptr); }
+
       //  generated copy constructor, assignment, destructor are fine.
       
       /** @brief  If @a __r is empty, constructs an empty %__shared_ptr;
@@ -857,7 +1442,7 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	    // Q: How can we get here?
 	    // A: Another thread may have invalidated r after the
 	    //    use_count test above.
-	    return __shared_ptr<element_type>();
+	    return __shared_ptr<element_type, _Lp>();
 	  }
 	
 #else
@@ -999,6 +1584,11 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
         shared_ptr(std::auto_ptr<_Tp1>& __r)
 	: __shared_ptr<_Tp>(__r) { }
 
+      template<typename _Alloc>
+        shared_ptr(_Sp_counted_inplace<_Tp, _Alloc,
+		   __default_lock_policy>* __p, _Sp_make_shared_tag)
+	: __shared_ptr<_Tp>(__p, _Sp_make_shared_tag()) { }
+
       template<typename _Tp1>
         shared_ptr(const shared_ptr<_Tp1>& __r, __static_cast_tag)
 	: __shared_ptr<_Tp>(__r, __static_cast_tag()) { }
@@ -1146,4 +1736,8 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 _GLIBCXX_END_NAMESPACE
 } // namespace std
 
+#define _GLIBCXX_REPEAT_HEADER <tr1/make_shared_iterate.h>
+#include <tr1/repeat.h>
+#undef _GLIBCXX_REPEAT_HEADER
+
 #endif
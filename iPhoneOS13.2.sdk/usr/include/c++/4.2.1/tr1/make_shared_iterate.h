@@ -0,0 +1,122 @@
+// TR1 shared_ptr factories -*- C++ -*-
+
+// Copyright (C) 2007 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file tr1/make_shared_iterate.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+namespace std
+{
+_GLIBCXX_BEGIN_NAMESPACE(tr1)
+
+/**
+ *  @if maint
+ *  Allocates a control block from @a __a and constructs a _Tp in it
+ *  from the arguments.  If the constructor throws, the block is freed.
+ *  @endif
+ */
+template<typename _Tp, _Lock_policy _Lp, typename _Alloc _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  _Sp_counted_inplace<_Tp, _Alloc, _Lp>*
+  __make_shared_block(const _Alloc& __a _GLIBCXX_COMMA _GLIBCXX_CREF_PARAMS)
+  {
+    typedef _Sp_counted_inplace<_Tp, _Alloc, _Lp> _Block;
+    _Block* __p = _Block::_S_create(__a);
+    try
+      {
+        ::new(__p->_M_storage()) _Tp(_GLIBCXX_ARGS);
+      }
+    catch(...)
+      {
+        _Block::_S_discard(__p);
+        __throw_exception_again;
+      }
+    return __p;
+  }
+
+template<typename _Tp, _Lock_policy _Lp, typename _Alloc _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  inline __shared_ptr<_Tp, _Lp>
+  __allocate_shared(const _Alloc& __a _GLIBCXX_COMMA _GLIBCXX_CREF_PARAMS)
+  {
+    return __shared_ptr<_Tp, _Lp>(__make_shared_block<_Tp, _Lp>(__a
+                                    _GLIBCXX_COMMA _GLIBCXX_ARGS),
+                                  _Sp_make_shared_tag());
+  }
+
+template<typename _Tp, _Lock_policy _Lp _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  inline __shared_ptr<_Tp, _Lp>
+  __make_shared(_GLIBCXX_CREF_PARAMS)
+  {
+    typedef typename remove_cv<_Tp>::type _Tp_nc;
+    return __allocate_shared<_Tp, _Lp>(std::allocator<_Tp_nc>()
+                                       _GLIBCXX_COMMA _GLIBCXX_ARGS);
+  }
+
+/**
+ *  @brief  Creates an object owned by a shared_ptr, with a single
+ *          allocation from @a a for the object and its reference counts.
+ *  @param  a  An allocator; copies of it, rebound, allocate and free
+ *             the storage.
+ *  @return A shared_ptr that owns a _Tp constructed from the remaining
+ *          arguments, which are passed as const references.
+ *  @throw  Whatever @a a or the constructor of _Tp throws, in which case
+ *          nothing is leaked.
+ */
+template<typename _Tp, typename _Alloc _GLIBCXX_COMMA
+         _GLIBCXX_TEMPLATE_PARAMS>
+  inline shared_ptr<_Tp>
+  allocate_shared(const _Alloc& __a _GLIBCXX_COMMA _GLIBCXX_CREF_PARAMS)
+  {
+    return shared_ptr<_Tp>(__make_shared_block<_Tp, __default_lock_policy>
+                           (__a _GLIBCXX_COMMA _GLIBCXX_ARGS),
+                           _Sp_make_shared_tag());
+  }
+
+/**
+ *  @brief  Creates an object owned by a shared_ptr, with a single
+ *          allocation for the object and its reference counts.
+ *  @return A shared_ptr that owns a _Tp constructed from the arguments,
+ *          which are passed as const references.
+ *  @throw  std::bad_alloc, or whatever the constructor of _Tp throws, in
+ *          which case nothing is leaked.
+ */
+template<typename _Tp _GLIBCXX_COMMA _GLIBCXX_TEMPLATE_PARAMS>
+  inline shared_ptr<_Tp>
+  make_shared(_GLIBCXX_CREF_PARAMS)
+  {
+    typedef typename remove_cv<_Tp>::type _Tp_nc;
+    return tr1::allocate_shared<_Tp>(std::allocator<_Tp_nc>()
+                                     _GLIBCXX_COMMA _GLIBCXX_ARGS);
+  }
+
+_GLIBCXX_END_NAMESPACE
+}
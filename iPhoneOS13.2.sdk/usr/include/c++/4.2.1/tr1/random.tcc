@@ -215,6 +215,43 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	_M_p = state_size;
       }
 
+  // The y & 1 test is done with a mask, so that both loops are
+  // straight-line code the compiler can vectorize: a new element reads
+  // only old elements ahead of it, or new ones n - m or more behind it.
+  template<class _UIntType, int __w, int __n, int __m, int __r,
+	   _UIntType __a, int __u, int __s,
+	   _UIntType __b, int __t, _UIntType __c, int __l>
+    void
+    mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
+		     __b, __t, __c, __l>::
+    _M_gen_rand()
+    {
+      const _UIntType __upper_mask = (~_UIntType()) << __r;
+      const _UIntType __lower_mask = ~__upper_mask;
+
+      for (int __k = 0; __k < (__n - __m); ++__k)
+	{
+	  _UIntType __y = ((_M_x[__k] & __upper_mask)
+			   | (_M_x[__k + 1] & __lower_mask));
+	  _M_x[__k] = (_M_x[__k + __m] ^ (__y >> 1)
+		       ^ (-(__y & 0x01) & __a));
+	}
+
+      for (int __k = (__n - __m); __k < (__n - 1); ++__k)
+	{
+	  _UIntType __y = ((_M_x[__k] & __upper_mask)
+			   | (_M_x[__k + 1] & __lower_mask));
+	  _M_x[__k] = (_M_x[__k + (__m - __n)] ^ (__y >> 1)
+		       ^ (-(__y & 0x01) & __a));
+	}
+
+      _UIntType __y = ((_M_x[__n - 1] & __upper_mask)
+		       | (_M_x[0] & __lower_mask));
+      _M_x[__n - 1] = (_M_x[__m - 1] ^ (__y >> 1)
+		       ^ (-(__y & 0x01) & __a));
+      _M_p = 0;
+    }
+
   template<class _UIntType, int __w, int __n, int __m, int __r,
 	   _UIntType __a, int __u, int __s,
 	   _UIntType __b, int __t, _UIntType __c, int __l>
@@ -227,42 +264,66 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
     {
       // Reload the vector - cost is O(n) amortized over n calls.
       if (_M_p >= state_size)
-	{
-	  const _UIntType __upper_mask = (~_UIntType()) << __r;
-	  const _UIntType __lower_mask = ~__upper_mask;
+	_M_gen_rand();
 
-	  for (int __k = 0; __k < (__n - __m); ++__k)
-	    {
-	      _UIntType __y = ((_M_x[__k] & __upper_mask)
-			       | (_M_x[__k + 1] & __lower_mask));
-	      _M_x[__k] = (_M_x[__k + __m] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	    }
+      // Calculate o(x(i)).
+      return _S_temper(_M_x[_M_p++]);
+    }
 
-	  for (int __k = (__n - __m); __k < (__n - 1); ++__k)
-	    {
-	      _UIntType __y = ((_M_x[__k] & __upper_mask)
-			       | (_M_x[__k + 1] & __lower_mask));
-	      _M_x[__k] = (_M_x[__k + (__m - __n)] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	    }
+  template<class _UIntType, int __w, int __n, int __m, int __r,
+	   _UIntType __a, int __u, int __s,
+	   _UIntType __b, int __t, _UIntType __c, int __l>
+    template<class _ForwardIterator>
+      void
+      mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
+		       __b, __t, __c, __l>::
+      generate(_ForwardIterator __first, _ForwardIterator __last)
+      { _M_generate(__first, __last, std::__iterator_category(__first)); }
 
-	  _UIntType __y = ((_M_x[__n - 1] & __upper_mask)
-			   | (_M_x[0] & __lower_mask));
-	  _M_x[__n - 1] = (_M_x[__m - 1] ^ (__y >> 1)
-			   ^ ((__y & 0x01) ? __a : 0));
-	  _M_p = 0;
-	}
+  template<class _UIntType, int __w, int __n, int __m, int __r,
+	   _UIntType __a, int __u, int __s,
+	   _UIntType __b, int __t, _UIntType __c, int __l>
+    template<class _ForwardIterator>
+      void
+      mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
+		       __b, __t, __c, __l>::
+      _M_generate(_ForwardIterator __first, _ForwardIterator __last,
+		  std::forward_iterator_tag)
+      {
+	for (; __first != __last; ++__first)
+	  *__first = (*this)();
+      }
 
-      // Calculate o(x(i)).
-      result_type __z = _M_x[_M_p++];
-      __z ^= (__z >> __u);
-      __z ^= (__z << __s) & __b;
-      __z ^= (__z << __t) & __c;
-      __z ^= (__z >> __l);
+  // Tempers a run of the state vector at a time, straight into the
+  // output, in a loop without other exits that the compiler vectorizes.
+  template<class _UIntType, int __w, int __n, int __m, int __r,
+	   _UIntType __a, int __u, int __s,
+	   _UIntType __b, int __t, _UIntType __c, int __l>
+    template<class _RandomAccessIterator>
+      void
+      mersenne_twister<_UIntType, __w, __n, __m, __r, __a, __u, __s,
+		       __b, __t, __c, __l>::
+      _M_generate(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		  std::random_access_iterator_tag)
+      {
+	typedef typename std::iterator_traits<_RandomAccessIterator>::
+	  difference_type _Distance;
 
-      return __z;
-    }
+	_Distance __len = __last - __first;
+	while (__len > 0)
+	  {
+	    if (_M_p >= state_size)
+	      _M_gen_rand();
+	    const _Distance __chunk = std::min(__len,
+					       _Distance(state_size - _M_p));
+	    const _UIntType* __x = _M_x + _M_p;
+	    for (_Distance __i = 0; __i < __chunk; ++__i)
+	      __first[__i] = _S_temper(__x[__i]);
+	    _M_p += __chunk;
+	    __first += __chunk;
+	    __len -= __chunk;
+	  }
+      }
 
   template<class _UIntType, int __w, int __n, int __m, int __r,
 	   _UIntType __a, int __u, int __s, _UIntType __b, int __t,
@@ -749,6 +810,141 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
     }
 
 
+  template<typename _IntType>
+    template<typename _UniformRandomNumberGenerator>
+      inline typename uniform_int<_IntType>::result_type
+      uniform_int<_IntType>::
+      _M_call(_UniformRandomNumberGenerator& __urng,
+	      result_type __min, result_type __max, true_type)
+      {
+	typedef typename _UniformRandomNumberGenerator::result_type
+	  _UResult_type;
+	typedef typename __detail::_Uniform_int_utype<_IntType,
+	  _UResult_type>::__type __utype;
+	typedef __detail::_UInt32Type _UInt32Type;
+
+	const __utype __urngrange = (__utype(__urng.max())
+				     - __utype(__urng.min()));
+	const __utype __urange = __utype(__max) - __utype(__min);
+
+	if ((unsigned long long)__urngrange == 0xffffffffULL
+	    && __urange < __urngrange)
+	  return result_type(__detail::__lemire<_UInt32Type,
+			     unsigned long long>(__urng,
+						 _UInt32Type(__urange + 1))
+			     + __utype(__min));
+#ifdef __SIZEOF_INT128__
+	if ((unsigned long long)__urngrange == ~0ULL
+	    && __urange < __urngrange)
+	  return result_type(__detail::__lemire<unsigned long long,
+			     __detail::_UInt128Type>(__urng,
+				(unsigned long long)(__urange + 1))
+			     + __utype(__min));
+#endif
+	return _M_rescale(__urng, __min, __max);
+      }
+
+  template<typename _IntType>
+    template<typename _UniformRandomNumberGenerator>
+      typename uniform_int<_IntType>::result_type
+      uniform_int<_IntType>::
+      _M_rescale(_UniformRandomNumberGenerator& __urng,
+		 result_type __min, result_type __max)
+      {
+	typedef typename _UniformRandomNumberGenerator::result_type
+	  _UResult_type;
+	typedef typename __detail::_Uniform_int_utype<_IntType,
+	  _UResult_type>::__type __utype;
+
+	const __utype __urngmin = __urng.min();
+	const __utype __urngrange = __utype(__urng.max()) - __urngmin;
+	const __utype __urange = __utype(__max) - __utype(__min);
+
+	__utype __ret;
+	if (__urngrange > __urange)
+	  {
+	    // Reject the incomplete last bucket, then divide.
+	    const __utype __uerange = __urange + 1;
+	    const __utype __scaling = __urngrange / __uerange;
+	    const __utype __past = __uerange * __scaling;
+	    do
+	      __ret = __utype(__urng()) - __urngmin;
+	    while (__ret >= __past);
+	    __ret /= __scaling;
+	  }
+	else if (__urngrange == 0)
+	  {
+	    // An engine with a single value cannot be combined into a
+	    // wider range; draw it once and return the degenerate result.
+	    __urng();
+	    __ret = 0;
+	  }
+	else if (__urngrange < __urange)
+	  {
+	    // A range wider than the engine's: combine several values,
+	    // rejecting those that overshoot or wrap around.
+	    const __utype __uerngrange = __urngrange + 1;
+	    __utype __tmp;
+	    do
+	      {
+		__tmp = __uerngrange
+		  * __utype(_M_call(__urng, 0,
+				    result_type(__urange / __uerngrange),
+				    true_type()));
+		__ret = __tmp + (__utype(__urng()) - __urngmin);
+	      }
+	    while (__ret > __urange || __ret < __tmp);
+	  }
+	else
+	  __ret = __utype(__urng()) - __urngmin;
+
+	return result_type(__ret + __utype(__min));
+      }
+
+  template<typename _IntType>
+    template<typename _ForwardIterator,
+	     typename _UniformRandomNumberGenerator>
+      void
+      uniform_int<_IntType>::
+      _M_generate(_ForwardIterator __first, _ForwardIterator __last,
+		  _UniformRandomNumberGenerator& __urng, true_type)
+      {
+	typedef typename _UniformRandomNumberGenerator::result_type
+	  _UResult_type;
+	typedef typename __detail::_Uniform_int_utype<_IntType,
+	  _UResult_type>::__type __utype;
+	typedef __detail::_UInt32Type _UInt32Type;
+
+	const __utype __urngrange = (__utype(__urng.max())
+				     - __utype(__urng.min()));
+	const __utype __urange = __utype(_M_max) - __utype(_M_min);
+
+	if ((unsigned long long)__urngrange == 0xffffffffULL
+	    && __urange < __urngrange)
+	  {
+	    const _UInt32Type __s = __urange + 1;
+	    const _UInt32Type __t = _UInt32Type(-__s) % __s;
+	    for (; __first != __last; ++__first)
+	      *__first = result_type(__detail::__lemire<_UInt32Type,
+				     unsigned long long>(__urng, __s, __t)
+				     + __utype(_M_min));
+	  }
+#ifdef __SIZEOF_INT128__
+	else if ((unsigned long long)__urngrange == ~0ULL
+		 && __urange < __urngrange)
+	  {
+	    const unsigned long long __s = __urange + 1;
+	    const unsigned long long __t = (-__s) % __s;
+	    for (; __first != __last; ++__first)
+	      *__first = result_type(__detail::__lemire<unsigned long long,
+				     __detail::_UInt128Type>(__urng, __s, __t)
+				     + __utype(_M_min));
+	  }
+#endif
+	else
+	  __detail::__generate(__first, __last, *this, __urng);
+      }
+
   template<typename _IntType, typename _CharT, typename _Traits>
     std::basic_ostream<_CharT, _Traits>&
     operator<<(std::basic_ostream<_CharT, _Traits>& __os,
@@ -1323,10 +1519,143 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
     }
 
 
-  template<typename _RealType, typename _CharT, typename _Traits>
+  namespace __detail
+  {
+    /**
+     * The ziggurat of Marsaglia and Tsang for exp(-x * x / 2) (_Normal)
+     * or exp(-x) on [0, inf): _S_layers horizontal layers of equal area
+     * v stacked under the curve.  Layer i spans [0, _M_x[i]) across and
+     * [_M_f[i], _M_f[i + 1]) up, where _M_f[i] is the density at
+     * _M_x[i].  The bottom layer is the strip below the density at
+     * r = _M_x[1], with the tail beyond r, and _M_x[0] = v / f(r) is the
+     * width of a rectangle of the same area.  The tables are computed
+     * the first time they are used.
+     *
+     * Reference:
+     * Marsaglia, G. and Tsang, W. W. "The Ziggurat Method for Generating
+     * Random Variables." Journal of Statistical Software, 5, 1-7, 2000.
+     */
+    template<typename _RealType, bool _Normal>
+      struct _Ziggurat
+      {
+	enum { _S_layers = 256 };
+
+	_RealType _M_x[_S_layers + 1];
+	_RealType _M_f[_S_layers + 1];
+
+	static const _Ziggurat&
+	_S_instance()
+	{
+	  static const _Ziggurat __z;
+	  return __z;
+	}
+
+	static long double
+	_S_density(long double __x)
+	{ return _Normal ? std::exp(-__x * __x / 2) : std::exp(-__x); }
+
+	_Ziggurat()
+	{
+	  // r, and the area v of one layer, for 256 layers.
+	  const long double __r = (_Normal ? 3.6541528853610088L
+				   : 7.6971174701310497L);
+	  const long double __v = (_Normal ? 4.9286732339746582e-3L
+				   : 3.9496598225815572e-3L);
+
+	  long double __x = __r;
+	  long double __f = _S_density(__r);
+	  _M_x[0] = _RealType(__v / __f);
+	  _M_f[0] = 0;
+	  for (int __i = 1; __i < _S_layers; ++__i)
+	    {
+	      _M_x[__i] = _RealType(__x);
+	      _M_f[__i] = _RealType(__f);
+	      __f += __v / __x;
+	      if (__f >= 1)
+		__x = 0;
+	      else
+		__x = _Normal ? std::sqrt(-2 * std::log(__f)) : -std::log(__f);
+	    }
+	  _M_x[_S_layers] = 0;
+	  _M_f[_S_layers] = 1;
+	}
+      };
+
+    // Two uniform values per try: one is scaled to the width of a layer
+    // chosen with the other, which is never scaled, so that the value
+    // keeps the full precision of the generator.  About 99% of the tries
+    // return at once; the rest test the density itself or draw from the
+    // tail.
+    template<typename _RealType, typename _UniformRandomNumberGenerator>
+      _RealType
+      __ziggurat_normal(_UniformRandomNumberGenerator& __urng)
+      {
+	typedef _Ziggurat<_RealType, true> _Table;
+	const _Table& __z = _Table::_S_instance();
+
+	for (;;)
+	  {
+	    const _RealType __u = 2 * _RealType(__urng()) - 1;
+	    const int __i = int(__urng() * _Table::_S_layers)
+			    & (_Table::_S_layers - 1);
+	    const _RealType __x = __u * __z._M_x[__i];
+	    if (std::abs(__x) < __z._M_x[__i + 1])
+	      return __x;
+
+	    if (__i == 0)
+	      {
+		// Marsaglia's method for the tail beyond r.
+		const _RealType __r = __z._M_x[1];
+		_RealType __t, __y;
+		do
+		  {
+		    __t = -std::log(1 - _RealType(__urng())) / __r;
+		    __y = -std::log(1 - _RealType(__urng()));
+		  }
+		while (__y + __y < __t * __t);
+		return __u < 0 ? -(__r + __t) : __r + __t;
+	      }
+
+	    const _RealType __f = (__z._M_f[__i] + _RealType(__urng())
+				   * (__z._M_f[__i + 1] - __z._M_f[__i]));
+	    if (__f < std::exp(-__x * __x / 2))
+	      return __x;
+	  }
+      }
+
+    template<typename _RealType, typename _UniformRandomNumberGenerator>
+      _RealType
+      __ziggurat_exponential(_UniformRandomNumberGenerator& __urng)
+      {
+	typedef _Ziggurat<_RealType, false> _Table;
+	const _Table& __z = _Table::_S_instance();
+
+	for (;;)
+	  {
+	    const _RealType __u = __urng();
+	    const int __i = int(__urng() * _Table::_S_layers)
+			    & (_Table::_S_layers - 1);
+	    const _RealType __x = __u * __z._M_x[__i];
+	    if (__x < __z._M_x[__i + 1])
+	      return __x;
+
+	    // The tail beyond r is r plus another exponential value.
+	    if (__i == 0)
+	      return __z._M_x[1] - std::log(1 - _RealType(__urng()));
+
+	    const _RealType __f = (__z._M_f[__i] + _RealType(__urng())
+				   * (__z._M_f[__i + 1] - __z._M_f[__i]));
+	    if (__f < std::exp(-__x))
+	      return __x;
+	  }
+      }
+  } // namespace __detail
+
+  template<typename _RealType, typename _Method,
+	   typename _CharT, typename _Traits>
     std::basic_ostream<_CharT, _Traits>&
     operator<<(std::basic_ostream<_CharT, _Traits>& __os,
-	       const exponential_distribution<_RealType>& __x)
+	       const exponential_distribution<_RealType, _Method>& __x)
     {
       typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
       typedef typename __ostream_type::ios_base    __ios_base;
@@ -1353,11 +1682,12 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
    * Devroye, L. "Non-Uniform Random Variates Generation." Springer-Verlag,
    * New York, 1986, Ch. V, Sect. 4.4.
    */
-  template<typename _RealType>
+  template<typename _RealType, typename _Method>
     template<class _UniformRandomNumberGenerator>
-      typename normal_distribution<_RealType>::result_type
-      normal_distribution<_RealType>::
-      operator()(_UniformRandomNumberGenerator& __urng)
+      typename normal_distribution<_RealType, _Method>::result_type
+      normal_distribution<_RealType, _Method>::
+      _M_call(_UniformRandomNumberGenerator& __urng,
+	      __gnu_cxx::classic_sampling)
       {
 	result_type __ret;
 
@@ -1382,15 +1712,14 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	    _M_saved_available = true;
 	    __ret = __y * __mult;
 	  }
-	
-	__ret = __ret * _M_sigma + _M_mean;
 	return __ret;
       }
 
-  template<typename _RealType, typename _CharT, typename _Traits>
+  template<typename _RealType, typename _Method,
+	   typename _CharT, typename _Traits>
     std::basic_ostream<_CharT, _Traits>&
     operator<<(std::basic_ostream<_CharT, _Traits>& __os,
-	       const normal_distribution<_RealType>& __x)
+	       const normal_distribution<_RealType, _Method>& __x)
     {
       typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
       typedef typename __ostream_type::ios_base    __ios_base;
@@ -1415,10 +1744,11 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
       return __os;
     }
 
-  template<typename _RealType, typename _CharT, typename _Traits>
+  template<typename _RealType, typename _Method,
+	   typename _CharT, typename _Traits>
     std::basic_istream<_CharT, _Traits>&
     operator>>(std::basic_istream<_CharT, _Traits>& __is,
-	       normal_distribution<_RealType>& __x)
+	       normal_distribution<_RealType, _Method>& __x)
     {
       typedef std::basic_istream<_CharT, _Traits>  __istream_type;
       typedef typename __istream_type::ios_base    __ios_base;
@@ -1436,10 +1766,10 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
     }
 
 
-  template<typename _RealType>
+  template<typename _RealType, typename _Method>
     void
-    gamma_distribution<_RealType>::
-    _M_initialize()
+    gamma_distribution<_RealType, _Method>::
+    _M_initialize(__gnu_cxx::classic_sampling)
     {
       if (_M_alpha >= 1)
 	_M_l_d = std::sqrt(2 * _M_alpha - 1);
@@ -1464,11 +1794,12 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
    * Devroye, L. "Non-Uniform Random Variates Generation." Springer-Verlag,
    * New York, 1986, Ch. IX, Sect. 3.4 (+ Errata!).
    */
-  template<typename _RealType>
+  template<typename _RealType, typename _Method>
     template<class _UniformRandomNumberGenerator>
-      typename gamma_distribution<_RealType>::result_type
-      gamma_distribution<_RealType>::
-      operator()(_UniformRandomNumberGenerator& __urng)
+      typename gamma_distribution<_RealType, _Method>::result_type
+      gamma_distribution<_RealType, _Method>::
+      _M_call(_UniformRandomNumberGenerator& __urng,
+	      __gnu_cxx::classic_sampling)
       {
 	result_type __x;
 
@@ -1520,10 +1851,63 @@ _GLIBCXX_BEGIN_NAMESPACE(tr1)
 	return __x;
       }
 
-  template<typename _RealType, typename _CharT, typename _Traits>
+  template<typename _RealType, typename _Method>
+    void
+    gamma_distribution<_RealType, _Method>::
+    _M_initialize(__gnu_cxx::ziggurat_sampling)
+    {
+      const result_type __a = _M_alpha < 1 ? _M_alpha + 1 : _M_alpha;
+      _M_l_d = 1 / std::sqrt(9 * __a - 3);
+    }
+
+  /**
+   * Marsaglia and Tsang's squeeze method, a rejection from a transformed
+   * normal value that accepts most candidates without a logarithm.  For
+   * alpha < 1, a value for alpha + 1 is scaled by U^(1 / alpha).
+   *
+   * Reference:
+   * Marsaglia, G. and Tsang, W. W. "A Simple Method for Generating Gamma
+   * Variables." ACM Transactions on Mathematical Software, 26, 363-372,
+   * 2000.
+   */
+  template<typename _RealType, typename _Method>
+    template<class _UniformRandomNumberGenerator>
+      typename gamma_distribution<_RealType, _Method>::result_type
+      gamma_distribution<_RealType, _Method>::
+      _M_call(_UniformRandomNumberGenerator& __urng,
+	      __gnu_cxx::ziggurat_sampling)
+      {
+	const result_type __a = _M_alpha < 1 ? _M_alpha + 1 : _M_alpha;
+	const result_type __d = __a - result_type(1) / 3;
+
+	result_type __x, __v, __u;
+	do
+	  {
+	    do
+	      {
+		__x = __detail::__ziggurat_normal<result_type>(__urng);
+		__v = 1 + _M_l_d * __x;
+	      }
+	    while (__v <= 0);
+
+	    __v = __v * __v * __v;
+	    __u = 1 - __urng();
+	    __x *= __x;
+	  }
+	while (__u > 1 - result_type(0.0331) * __x * __x
+	       && (std::log(__u)
+		   > __x / 2 + __d * (1 - __v + std::log(__v))));
+
+	if (_M_alpha < 1)
+	  return __d * __v * std::pow(1 - __urng(), 1 / _M_alpha);
+	return __d * __v;
+      }
+
+  template<typename _RealType, typename _Method,
+	   typename _CharT, typename _Traits>
     std::basic_ostream<_CharT, _Traits>&
     operator<<(std::basic_ostream<_CharT, _Traits>& __os,
-	       const gamma_distribution<_RealType>& __x)
+	       const gamma_distribution<_RealType, _Method>& __x)
     {
       typedef std::basic_ostream<_CharT, _Traits>  __ostream_type;
       typedef typename __ostream_type::ios_base    __ios_base;
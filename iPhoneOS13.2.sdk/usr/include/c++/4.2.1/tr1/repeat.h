@@ -49,6 +49,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS
 #define _GLIBCXX_PARAMS
 #define _GLIBCXX_REF_PARAMS
+#define _GLIBCXX_CREF_PARAMS
 #define _GLIBCXX_ARGS
 #define _GLIBCXX_COMMA_SHIFTED
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
@@ -94,6 +95,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -107,6 +109,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1
 #define _GLIBCXX_PARAMS _T1 __a1
 #define _GLIBCXX_REF_PARAMS _T1& __a1
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1
 #define _GLIBCXX_ARGS __a1
 #define _GLIBCXX_COMMA_SHIFTED
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
@@ -152,6 +155,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -165,6 +169,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2
 #define _GLIBCXX_ARGS __a1, __a2
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1
@@ -210,6 +215,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -222,6 +228,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3
 #define _GLIBCXX_ARGS __a1, __a2, __a3
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2
@@ -267,6 +274,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -279,6 +287,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3
@@ -324,6 +333,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -336,6 +346,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4
@@ -381,6 +392,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -393,6 +405,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5, _T6
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5, _T6 __a6
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5, _T6& __a6
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5, const _T6& __a6
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5, __a6
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4, typename _T5
@@ -438,6 +451,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -450,6 +464,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5, _T6, _T7
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5, _T6 __a6, _T7 __a7
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5, _T6& __a6, _T7& __a7
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5, const _T6& __a6, const _T7& __a7
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5, __a6, __a7
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4, typename _T5, typename _T6
@@ -495,6 +510,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -507,6 +523,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5, _T6, _T7, _T8
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5, _T6 __a6, _T7 __a7, _T8 __a8
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5, _T6& __a6, _T7& __a7, _T8& __a8
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5, const _T6& __a6, const _T7& __a7, const _T8& __a8
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5, __a6, __a7, __a8
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4, typename _T5, typename _T6, typename _T7
@@ -552,6 +569,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -564,6 +582,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5, _T6, _T7, _T8, _T9
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5, _T6 __a6, _T7 __a7, _T8 __a8, _T9 __a9
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5, _T6& __a6, _T7& __a7, _T8& __a8, _T9& __a9
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5, const _T6& __a6, const _T7& __a7, const _T8& __a8, const _T9& __a9
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5, __a6, __a7, __a8, __a9
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4, typename _T5, typename _T6, typename _T7, typename _T8
@@ -609,6 +628,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS
@@ -622,6 +642,7 @@
 #define _GLIBCXX_TEMPLATE_ARGS _T1, _T2, _T3, _T4, _T5, _T6, _T7, _T8, _T9, _T10
 #define _GLIBCXX_PARAMS _T1 __a1, _T2 __a2, _T3 __a3, _T4 __a4, _T5 __a5, _T6 __a6, _T7 __a7, _T8 __a8, _T9 __a9, _T10 __a10
 #define _GLIBCXX_REF_PARAMS _T1& __a1, _T2& __a2, _T3& __a3, _T4& __a4, _T5& __a5, _T6& __a6, _T7& __a7, _T8& __a8, _T9& __a9, _T10& __a10
+#define _GLIBCXX_CREF_PARAMS const _T1& __a1, const _T2& __a2, const _T3& __a3, const _T4& __a4, const _T5& __a5, const _T6& __a6, const _T7& __a7, const _T8& __a8, const _T9& __a9, const _T10& __a10
 #define _GLIBCXX_ARGS __a1, __a2, __a3, __a4, __a5, __a6, __a7, __a8, __a9, __a10
 #define _GLIBCXX_COMMA_SHIFTED ,
 #define _GLIBCXX_TEMPLATE_PARAMS_SHIFTED typename _T1, typename _T2, typename _T3, typename _T4, typename _T5, typename _T6, typename _T7, typename _T8, typename _T9
@@ -667,6 +688,7 @@
 #undef _GLIBCXX_TEMPLATE_PARAMS_SHIFTED
 #undef _GLIBCXX_COMMA_SHIFTED
 #undef _GLIBCXX_ARGS
+#undef _GLIBCXX_CREF_PARAMS
 #undef _GLIBCXX_REF_PARAMS
 #undef _GLIBCXX_PARAMS
 #undef _GLIBCXX_TEMPLATE_ARGS